@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vvipers/Engine/OptionsJSON.hpp>
+#include <vvipers/Engine/TextureFileLoader.hpp>
+#include <vvipers/GameElements/Viper.hpp>
+#include <vvipers/Utilities/Time.hpp>
+#include <vvipers/Utilities/debug.hpp>
+#include <vvipers/config.hpp>
+
+/* Replacing the global operator new affects the whole program, so these tests
+ * are built into an executable of their own. Allocations are only counted
+ * while an AllocationCounter exists. */
+
+namespace {
+std::atomic<bool> counting = false;
+std::atomic<size_t> allocation_count = 0;
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed))
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+using namespace VVipers;
+
+namespace {
+
+class AllocationCounter {
+  public:
+    AllocationCounter() {
+        allocation_count = 0;
+        counting = true;
+    }
+    ~AllocationCounter() { counting = false; }
+    size_t allocations() const { return allocation_count; }
+};
+
+TEST(AllocationTest, ViperSteadyStateTest) {
+    debug::verbosity = Verbosity::OnlyErrors;
+    OptionsJSON options("preferences.json");
+    options.set_option_string("General/resourceDirectoryPath", RESOURCE_PATH);
+    TextureFileLoader textures(options);
+    auto viper_cfg = std::make_shared<ViperConfiguration>(options, textures);
+    Viper viper(viper_cfg, Vec2(0, 0), 0.f, 1.5);
+
+    const Time frame_time = time_from_seconds(1. / 60);
+    viper.steer(45., 0.);
+    // Let it grow to full length and fill its memory pools
+    for (int frame = 0; frame < 600; ++frame)
+        viper.update(frame_time);
+    AllocationCounter counter;
+    for (int frame = 0; frame < 600; ++frame)
+        viper.update(frame_time);
+    EXPECT_EQ(counter.allocations(), 0u);
+}
+
+}  // namespace
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <set>
+#include <string>
+#include <tuple>
 #include <vvipers/Collisions/CollidingBody.hpp>
 #include <vvipers/Collisions/CollisionManager.hpp>
 #include <vvipers/Utilities/Shape.hpp>
@@ -24,6 +27,39 @@ class Body : public CollidingBody {
     const std::shared_ptr<const Shape> _shape;
 };
 
+// A row of circles grouped into chunks of chunk_size circles
+class ChainBody : public CollidingBody {
+  public:
+    ChainBody(const std::string& name, Vec2 start, Vec2 step, size_t length,
+              size_t chunk_size)
+        : CollidingBody(name), _chunk_size(chunk_size) {
+        for (size_t i = 0; i < length; ++i)
+            _shapes.push_back(std::make_shared<Circle>(start + i * step, 5));
+    }
+    size_t number_of_segments() const override { return _shapes.size(); }
+    std::shared_ptr<const Shape> segment_shape(size_t index) const override {
+        ++shape_requests;
+        return _shapes[index];
+    }
+    size_t number_of_chunks() const override {
+        return (_shapes.size() + _chunk_size - 1) / _chunk_size;
+    }
+    std::pair<size_t, size_t> chunk_segments(size_t chunk) const override {
+        return {chunk * _chunk_size,
+                std::min((chunk + 1) * _chunk_size, _shapes.size())};
+    }
+    BoundingBox chunk_bounding_box(size_t chunk) const override {
+        auto [begin, end] = chunk_segments(chunk);
+        auto box = _shapes[begin]->bounding_box();
+        for (size_t i = begin + 1; i < end; ++i)
+            box.include(_shapes[i]->bounding_box());
+        return box;
+    }
+    const size_t _chunk_size;
+    std::vector<std::shared_ptr<const Shape>> _shapes;
+    mutable size_t shape_requests = 0;  // About one per shape test
+};
+
 TEST(CollisionTest, ShapeRotationTest) {
     Polygon poly(Vec2(10, 2));
     poly.set_anchor(Vec2(-5, 0));
@@ -52,6 +88,30 @@ TEST(CollisionTest, ShapeTest) {
     EXPECT_FALSE(poly.overlap(circle2));
 }
 
+TEST(CollisionTest, CapsuleTest) {
+    Capsule capsule(Vec2(0, 0), Vec2(100, 0), 10);
+    EXPECT_TRUE(capsule.overlap(Circle(Vec2(50, 15), 6)));
+    EXPECT_FALSE(capsule.overlap(Circle(Vec2(50, 17), 6)));
+    // Past the end the rounded cap decides
+    EXPECT_TRUE(capsule.overlap(Circle(Vec2(112, 0), 3)));
+    EXPECT_FALSE(capsule.overlap(Circle(Vec2(110, 10), 3)));
+    EXPECT_TRUE(capsule.overlap(Capsule(Vec2(50, -50), Vec2(50, 50), 1)));
+    EXPECT_TRUE(capsule.overlap(Capsule(Vec2(0, 25), Vec2(100, 25), 16)));
+    EXPECT_FALSE(capsule.overlap(Capsule(Vec2(0, 25), Vec2(100, 25), 14)));
+    // Crossing a polygon, inside it and next to it
+    EXPECT_TRUE(capsule.overlap(Polygon(Vec2(2, 200))));
+    EXPECT_TRUE(Polygon(Vec2(500, 500)).overlap(capsule));
+    Polygon square(Vec2(10, 10));
+    square.move_to(Vec2(50, 14));
+    EXPECT_TRUE(capsule.overlap(square));
+    square.move_to(Vec2(50, 17));
+    EXPECT_FALSE(capsule.overlap(square));
+    capsule.rotate(pi / 2.);
+    EXPECT_LT((capsule.start() - Vec2(50, -50)).abs(), 0.000001);
+    capsule.move_to(Vec2(0, 0));
+    EXPECT_LT((capsule.end() - Vec2(0, 50)).abs(), 0.000001);
+}
+
 TEST(CollisionTest, ManagerTest) {
     std::vector<Vec2> corners;
     corners.emplace_back(0, 0);
@@ -84,4 +144,65 @@ TEST(CollisionTest, ManagerTest) {
               3);
 }
 
+TEST(CollisionTest, SweptTest) {
+    // A thin wall the head would jump over in a single update
+    Polygon wall_shape(Vec2(5, 100));
+    wall_shape.move_to(Vec2(50, 0));
+    Body wall(std::make_shared<Polygon>(wall_shape));
+    CollisionManager manager(4, 500);
+    manager.register_colliding_body(&wall);
+    EXPECT_FALSE(manager.is_occupied(Circle(Vec2(40, 0), 1)));
+    EXPECT_FALSE(manager.is_occupied(Circle(Vec2(60, 0), 1)));
+    auto overlapping =
+        manager.find_overlapping(Capsule(Vec2(40, 0), Vec2(60, 0), 1));
+    ASSERT_EQ(overlapping.size(), 1u);
+    EXPECT_EQ(overlapping.front().body, &wall);
+    EXPECT_TRUE(
+        manager.find_overlapping(Capsule(Vec2(40, 0), Vec2(45, 0), 1)).empty());
+}
+
+TEST(CollisionTest, ChunkTest) {
+    auto collisions = [](size_t chunk_size) {
+        ChainBody horizontal("Horizontal", Vec2(10, 100), Vec2(8, 0), 40,
+                             chunk_size);
+        ChainBody vertical("Vertical", Vec2(100, 10), Vec2(0, 8), 40,
+                           chunk_size);
+        CollisionManager manager(4, 3);
+        manager.register_colliding_body(&horizontal);
+        manager.register_colliding_body(&vertical);
+        std::set<std::tuple<std::string, size_t, std::string, size_t>> result;
+        for (const auto& [first, second] :
+             manager.check_for_collisions(BoundingBox(0, 500, 0, 500)))
+            result.emplace(
+                std::min(std::tuple(first.body->name(), first.index,
+                                    second.body->name(), second.index),
+                         std::tuple(second.body->name(), second.index,
+                                    first.body->name(), first.index)));
+        return result;
+    };
+    auto unchunked = collisions(1);
+    // Within a chain only the head collides, with its neighbour
+    EXPECT_TRUE(unchunked.contains({"Horizontal", 0, "Horizontal", 1}));
+    EXPECT_FALSE(unchunked.contains({"Horizontal", 1, "Horizontal", 2}));
+    EXPECT_TRUE(unchunked.contains({"Vertical", 0, "Vertical", 1}));
+    EXPECT_GT(unchunked.size(), 2);
+    EXPECT_EQ(collisions(7), unchunked);
+    EXPECT_EQ(collisions(16), unchunked);
+    EXPECT_EQ(collisions(40), unchunked);
+}
+
+TEST(CollisionTest, LongBodyTest) {
+    // A long body far from everything costs as much as a short one
+    auto shape_requests = [](size_t length) {
+        ChainBody body("Long", Vec2(10, 10), Vec2(4, 0), length, 16);
+        CollisionManager manager(4, 3);
+        manager.register_colliding_body(&body);
+        manager.check_for_collisions(BoundingBox(0, 10000, 0, 100));
+        return body.shape_requests;
+    };
+    size_t short_body = shape_requests(200);
+    EXPECT_LE(short_body, 64u);
+    EXPECT_EQ(shape_requests(2000), short_body);
+}
+
 }  // namespace
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vvipers/Engine/Engine.hpp>
+#include <vvipers/Engine/GameResources.hpp>
+#include <vvipers/Engine/HeadlessWindowManager.hpp>
+#include <vvipers/Engine/OptionsJSON.hpp>
+#include <vvipers/Engine/RenderSnapshot.hpp>
+#include <vvipers/Scenes/ArenaScene.hpp>
+#include <vvipers/Scenes/FlashScreenScene.hpp>
+#include <vvipers/Utilities/debug.hpp>
+#include <vvipers/config.hpp>
+
+using namespace VVipers;
+
+namespace {
+
+/** Quits the game when first updated and counts its updates **/
+class QuitScene : public Scene {
+  public:
+    QuitScene(GameResources& game_resources) : Scene(game_resources) {}
+    void draw(sf::RenderTarget&, sf::RenderStates) const override {}
+    void update(const Time&) override {
+        ++updates;
+        notify(SceneEvent(SceneEvent::SceneEventType::Quit));
+    }
+    int updates = 0;
+};
+
+std::unique_ptr<OptionsJSON> headless_options(double update_rate) {
+    auto options = std::make_unique<OptionsJSON>("preferences.json");
+    options->set_option_string("General/resourceDirectoryPath",
+                               RESOURCE_PATH);
+    options->set_option_boolean("General/headless", true);
+    options->set_option_double("General/FPS", 60);
+    options->set_option_double("General/updateRate", update_rate);
+    return options;
+}
+
+std::unique_ptr<GameResources> headless_resources(double update_rate) {
+    return std::make_unique<GameResources>(headless_options(update_rate));
+}
+
+sf::Event key_event(sf::Event::EventType type, sf::Keyboard::Scancode key) {
+    sf::Event event;
+    event.type = type;
+    event.key.scancode = key;
+    return event;
+}
+
+/** Remembers the frame of the first scene event **/
+class SceneEventWatcher : public Observer {
+  public:
+    SceneEventWatcher(const HeadlessWindowManager& window_manager)
+        : _window_manager(window_manager) {}
+    void on_notify(const GameEvent&) override {
+        if (!first_event_frame)
+            first_event_frame = _window_manager.frame();
+    }
+    size_t first_event_frame = 0;
+
+  private:
+    const HeadlessWindowManager& _window_manager;
+};
+
+/** Takes a while to draw each frame, and tells if it drew while a scene was
+ * created **/
+class SlowWindowManager : public HeadlessWindowManager {
+  public:
+    using HeadlessWindowManager::HeadlessWindowManager;
+    void draw(const sf::Drawable&) override {
+        drew_while_creating_scene = drew_while_creating_scene || creating_scene;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        drew_while_creating_scene = drew_while_creating_scene || creating_scene;
+    }
+    std::atomic<bool> creating_scene = false;
+    std::atomic<bool> drew_while_creating_scene = false;
+};
+
+/** Recorded for the render thread. Spawns a QuitScene when first updated,
+ * which takes a while to create. **/
+class SpawningScene : public Scene {
+  public:
+    SpawningScene(GameResources& game_resources,
+                  SlowWindowManager& window_manager)
+        : Scene(game_resources), _window_manager(window_manager) {}
+    void draw(sf::RenderTarget&, sf::RenderStates) const override {}
+    bool take_snapshot(RenderSnapshot&) const override { return true; }
+    void update(const Time&) override {
+        if (spawned)
+            return;
+        spawned = true;
+        SceneEvent scene_event(SceneEvent::SceneEventType::Spawn);
+        scene_event.scene_factory = [this] {
+            _window_manager.creating_scene = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            _window_manager.creating_scene = false;
+            return std::make_shared<QuitScene>(game_resources());
+        };
+        notify(scene_event);
+    }
+    bool spawned = false;
+
+  private:
+    SlowWindowManager& _window_manager;
+};
+
+/** Quiets the log while the game runs, and restores it for later tests **/
+class EngineTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        _verbosity = debug::verbosity;
+        debug::verbosity = Verbosity::OnlyErrors;
+    }
+    void TearDown() override { debug::verbosity = _verbosity; }
+
+  private:
+    Verbosity _verbosity;
+};
+
+TEST_F(EngineTest, FixedStepSceneChangeTest) {
+    // Several steps every frame, the flash screen ends within the first
+    Engine engine(headless_resources(600));
+    engine.add_scene(std::make_shared<FlashScreenScene>(
+        engine.game_resources(), time_from_seconds(0.001)));
+    auto quit_scene = std::make_shared<QuitScene>(engine.game_resources());
+    engine.set_default_scene(quit_scene);
+    engine.start_game();
+    // Neither scene is updated after it asked to be replaced
+    EXPECT_EQ(quit_scene->updates, 1);
+}
+
+TEST_F(EngineTest, ScriptedArenaTest) {
+    // One player steering with the keyboard, who pauses the game and closes
+    // the window
+    auto options = headless_options(0);
+    options->set_option_int("Players/numberOfPlayers", 1);
+    auto left = sf::Keyboard::Scancode(
+        options->option_int_array("Players/Player1/keys")[0]);
+    auto window_manager = std::make_unique<HeadlessWindowManager>(
+        sf::Vector2u(options->option_2d_vector("General/windowSize")));
+    auto& window = *window_manager;
+    window.set_input_script([=](size_t frame, auto& window) {
+        if (frame == 1)
+            window.push_event(key_event(sf::Event::KeyPressed, left));
+        else if (frame == 20)
+            window.push_event(key_event(sf::Event::KeyReleased, left));
+        else if (frame == 30)
+            window.push_event(
+                key_event(sf::Event::KeyPressed, sf::Keyboard::Scan::Escape));
+        else if (frame == 60) {
+            sf::Event closed;
+            closed.type = sf::Event::Closed;
+            window.push_event(closed);
+        }
+    });
+    Engine engine(std::make_unique<GameResources>(std::move(options),
+                                                  std::move(window_manager)));
+    auto& resources = engine.game_resources();
+    EXPECT_TRUE(resources.is_headless());
+    // Nothing that would need a graphics context
+    EXPECT_EQ(resources.font_service().default_font(), nullptr);
+    for (auto name : {"ViperHead", "ViperBody", "ViperTail"}) {
+        EXPECT_EQ(resources.texture_service().texture(name), nullptr);
+        EXPECT_GT(resources.texture_service().texture_rect(name).width, 0);
+    }
+    auto arena = std::make_shared<ArenaScene>(resources);
+    SceneEventWatcher watcher(window);
+    arena->add_observer(&watcher, {GameEvent::EventType::Scene});
+    engine.add_scene(arena);
+    engine.start_game();
+    // The pause screen was asked for when the script pressed escape
+    EXPECT_EQ(watcher.first_event_frame, 30u);
+    EXPECT_EQ(window.frame(), 61u);
+}
+
+// Draws, so unlike the other engine tests it needs a display
+class PipelinedEngineTest : public EngineTest {};
+
+TEST_F(PipelinedEngineTest, SceneCreationTest) {
+    // Drawn on a render thread, which is still drawing the frame recorded
+    // after the update that asked for the new scene
+    auto options = headless_options(0);
+    options->set_option_boolean("General/headless", false);
+    options->set_option_boolean("General/renderThread", true);
+    options->set_option_double("General/FPS", 1000);
+    auto window_manager = std::make_unique<SlowWindowManager>(
+        sf::Vector2u(options->option_2d_vector("General/windowSize")));
+    auto& window = *window_manager;
+    Engine engine(std::make_unique<GameResources>(std::move(options),
+                                                  std::move(window_manager)));
+    auto scene = std::make_shared<SpawningScene>(engine.game_resources(),
+                                                 window);
+    engine.add_scene(scene);
+    engine.start_game();
+    EXPECT_TRUE(scene->spawned);
+    EXPECT_FALSE(window.drew_while_creating_scene);
+}
+
+}  // namespace
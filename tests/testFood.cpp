@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <vvipers/GameElements/Food.hpp>
+#include <vvipers/GameElements/FoodBatch.hpp>
+#include <vvipers/Utilities/Time.hpp>
+
+using namespace VVipers;
+
+namespace {
+
+TEST(FoodBatchTest, PelletTest) {
+    Food food1(Vec2(100, 100), 10, time_from_seconds(5), sf::Color::Red);
+    Food food2(Vec2(300, 200), 20, time_from_seconds(5), sf::Color::Green);
+    food2.update(time_from_seconds(0.1));
+    FoodBatch batch;
+    batch.pack({&food1, &food2});
+    const auto& vertices = batch.vertices();
+    // Each edge is one fill triangle and a quad of outline
+    ASSERT_EQ(vertices.getVertexCount(),
+              9 * (food1.getPointCount() + food2.getPointCount()));
+    size_t food1_vertices = 9 * food1.getPointCount();
+    for (size_t i = 0; i < vertices.getVertexCount(); ++i) {
+        const Food& food = i < food1_vertices ? food1 : food2;
+        double distance_from_center =
+            distance(Vec2(vertices[i].position), Vec2(food.getPosition()));
+        // The fill triangles come first for every edge
+        if (i % 9 < 3) {
+            EXPECT_EQ(vertices[i].color, food.getFillColor());
+            EXPECT_LE(distance_from_center, food.getRadius() + 1e-3);
+        } else {
+            EXPECT_EQ(vertices[i].color, food.getOutlineColor());
+            EXPECT_LE(distance_from_center,
+                      food.getRadius() + 2 * food.getOutlineThickness());
+            EXPECT_GE(distance_from_center, food.getRadius() - 1e-3);
+        }
+    }
+}
+
+TEST(FoodBatchTest, DecayTest) {
+    Food food(Vec2(100, 100), 10, time_from_seconds(5), sf::Color::Red);
+    food.state(GameObject::Dying);
+    // Decay starts at the first update and lasts for a quarter of a second
+    food.update(time_from_seconds(0.1));
+    food.update(time_from_seconds(0.125));
+    // Shrinking does not change the shape, only its scale
+    EXPECT_EQ(food.getRadius(), 10);
+    FoodBatch batch;
+    batch.pack({&food});
+    EXPECT_NEAR(distance(Vec2(batch.vertices()[1].position),
+                         Vec2(food.getPosition())),
+                5, 1e-3);
+}
+
+TEST(FoodBatchTest, InterpolationTest) {
+    Food food(Vec2(100, 100), 10, time_from_seconds(5), sf::Color::Red);
+    food.state(GameObject::Dying);
+    food.update(time_from_seconds(0.1));
+    food.update(time_from_seconds(0.125));
+    // Halfway between the full size and the half size of the last update
+    EXPECT_NEAR(food.interpolated_scale(0.5), 0.75, 1e-6);
+    EXPECT_NEAR(food.interpolated_scale(1), 0.5, 1e-6);
+    FoodBatch batch;
+    batch.pack({&food}, 0);
+    EXPECT_NEAR(distance(Vec2(batch.vertices()[1].position),
+                         Vec2(food.getPosition())),
+                10, 1e-3);
+    // Turning past 360 degrees goes the short way
+    Food spinning(Vec2(100, 100), 10, time_from_seconds(5), sf::Color::Red);
+    spinning.setRotation(358);
+    spinning.update(time_from_seconds(0.1));
+    double step = 2 * Food::nominal_food_radius / 10;
+    ASSERT_GT(358 + step, 360);
+    EXPECT_NEAR(spinning.interpolated_rotation(0.5), 358 + 0.5 * step, 1e-3);
+}
+
+}  // namespace
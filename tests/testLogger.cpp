@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <vvipers/Utilities/Logger.hpp>
+#include <vvipers/Utilities/debug.hpp>
+
+using namespace VVipers;
+
+namespace {
+
+TEST(LoggerTest, OrderTest) {
+    std::ostringstream os;
+    auto& logger = Logger::instance();
+    // More records than fit in the queue at once
+    for (int i = 0; i < 3000; ++i)
+        logger.push(os, false, std::source_location::current(), "", i);
+    logger.flush();
+    std::istringstream lines(os.str());
+    std::string line;
+    int expected = 0;
+    while (std::getline(lines, line))
+        EXPECT_EQ(line, std::to_string(expected++));
+    EXPECT_EQ(expected, 3000);
+}
+
+TEST(LoggerTest, LargeRecordTest) {
+    std::ostringstream os;
+    auto& logger = Logger::instance();
+    std::string text(100, 'a');
+    // Too large for a record, formatted by the caller
+    logger.push(os, false, std::source_location::current(), "", text, text,
+                text, text, text, text, text, text);
+    logger.flush();
+    EXPECT_EQ(os.str(), std::string(800, 'a') + '\n');
+}
+
+TEST(LoggerTest, ThreadTest) {
+    std::ostringstream os;
+    auto& logger = Logger::instance();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&logger, &os] {
+            for (int i = 0; i < 500; ++i) {
+                std::string text = "line";
+                // The pointer dies before the record is written
+                logger.push(os, false, std::source_location::current(),
+                            "> ", text.c_str(), ' ', i);
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+    logger.flush();
+    std::istringstream lines(os.str());
+    std::string line;
+    int count = 0;
+    while (std::getline(lines, line)) {
+        EXPECT_EQ(line.substr(0, 7), "> line ");
+        ++count;
+    }
+    EXPECT_EQ(count, 2000);
+}
+
+TEST(LoggerTest, CopyTest) {
+    std::ostringstream os;
+    auto& logger = Logger::instance();
+    {
+        char buffer[] = "first";
+        std::string text = "second";
+        logger.push(os, false, std::source_location::current(), "", buffer,
+                    ' ', std::string_view(text));
+        // Neither change may reach the record
+        buffer[0] = 'X';
+        text.assign(text.size(), 'X');
+    }
+    logger.flush();
+    EXPECT_EQ(os.str(), "first second\n");
+}
+
+// The macros read LOG_LEVEL where they are used, so this pretends the build
+// only keeps errors
+#undef LOG_LEVEL
+#define LOG_LEVEL Verbosity::OnlyErrors
+
+TEST(LoggerTest, CompiledOutTest) {
+    int evaluated = 0;
+    log_info("Never written ", ++evaluated);
+    tag_warning("Never written ", ++evaluated);
+    _impl_log_if(ErrorsAndWarnings, ++evaluated);
+    EXPECT_EQ(evaluated, 0);
+    _impl_log_if(OnlyErrors, ++evaluated);
+    EXPECT_EQ(evaluated, 1);
+}
+
+}  // namespace
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <memory>
+#include <vvipers/GameElements/Observer.hpp>
+
+using namespace VVipers;
+
+namespace {
+
+class TestObservable : public Observable {
+  public:
+    void send(const GameEvent& event) { notify(event); }
+};
+
+struct EventCounter : public Observer {
+    void on_notify(const GameEvent&) override { ++events; }
+    int events = 0;
+};
+
+TEST(ObserverTest, DispatchTest) {
+    TestObservable observable;
+    EventCounter modified, scoring, both;
+    observable.add_observer(&modified, {GameEvent::EventType::ObjectModified});
+    observable.add_observer(&scoring, {GameEvent::EventType::Scoring});
+    observable.add_observer(&both, {GameEvent::EventType::ObjectModified,
+                                    GameEvent::EventType::Scoring});
+    observable.send(ObjectModifiedEvent(nullptr));
+    observable.send(ScoringEvent(1));
+    observable.send(DestroyEvent(nullptr));
+    EXPECT_EQ(modified.events, 1);
+    EXPECT_EQ(scoring.events, 1);
+    EXPECT_EQ(both.events, 2);
+
+    // Adding again replaces the event types
+    observable.add_observer(&both, {GameEvent::EventType::Destroy});
+    observable.send(ObjectModifiedEvent(nullptr));
+    observable.send(DestroyEvent(nullptr));
+    EXPECT_EQ(modified.events, 2);
+    EXPECT_EQ(both.events, 3);
+
+    observable.remove_observer(&modified);
+    observable.send(ObjectModifiedEvent(nullptr));
+    EXPECT_EQ(modified.events, 2);
+}
+
+// Removes an observer, possibly itself, when notified
+struct RemovingObserver : public EventCounter {
+    void on_notify(const GameEvent& event) override {
+        EventCounter::on_notify(event);
+        observable->remove_observer(removed);
+    }
+    Observable* observable = nullptr;
+    Observer* removed = nullptr;
+};
+
+TEST(ObserverTest, RemoveDuringDispatchTest) {
+    TestObservable observable;
+    RemovingObserver leaving, removing;
+    EventCounter next, removed, last;
+    leaving.observable = removing.observable = &observable;
+    leaving.removed = &leaving;
+    removing.removed = &removed;
+    for (Observer* observer : std::initializer_list<Observer*>{
+             &leaving, &next, &removing, &removed, &last})
+        observable.add_observer(observer, {GameEvent::EventType::Scoring});
+    observable.send(ScoringEvent(1));
+    // The observer after the one removing itself is still notified, the one
+    // removed before its turn is not
+    EXPECT_EQ(leaving.events, 1);
+    EXPECT_EQ(next.events, 1);
+    EXPECT_EQ(removing.events, 1);
+    EXPECT_EQ(removed.events, 0);
+    EXPECT_EQ(last.events, 1);
+
+    observable.send(ScoringEvent(1));
+    EXPECT_EQ(leaving.events, 1);
+    EXPECT_EQ(next.events, 2);
+    EXPECT_EQ(last.events, 2);
+}
+
+TEST(ObserverTest, LifetimeTest) {
+    EventCounter counter;
+    {
+        TestObservable observable;
+        observable.add_observer(&counter, {GameEvent::EventType::Scoring});
+    }
+    auto observable = std::make_unique<TestObservable>();
+    {
+        EventCounter short_lived;
+        observable->add_observer(&short_lived,
+                                 {GameEvent::EventType::Scoring});
+        observable->add_observer(&counter, {GameEvent::EventType::Scoring});
+    }
+    // The observer removed itself when destroyed
+    observable->send(ScoringEvent(1));
+    EXPECT_EQ(counter.events, 1);
+    observable.reset();  // Leaves counter with nothing to clean up
+}
+
+}  // namespace
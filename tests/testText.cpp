@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <SFML/Graphics/Font.hpp>
+#include <vvipers/UIElements/NumberBatch.hpp>
+#include <vvipers/config.hpp>
+
+using namespace VVipers;
+
+namespace {
+
+TEST(NumberBatchTest, NumberStringTest) {
+    NumberString text;
+    text << "+" << 1234;
+    EXPECT_EQ(text.view(), "+1234");
+    text.clear();
+    text << -5 << " / " << 10;
+    EXPECT_EQ(text.view(), "-5 / 10");
+}
+
+TEST(NumberBatchTest, TextTest) {
+    sf::Font font;
+    ASSERT_TRUE(font.loadFromFile(RESOURCE_PATH "DroidSansMono.ttf"));
+    NumberBatch batch(&font);
+    batch.add_text("12", Vec2(100, 100), 20, sf::Color::White);
+    const auto& vertices = batch.vertices();
+    // Two triangles per character
+    ASSERT_EQ(vertices.size(), 12);
+    // Centred horizontally on the position
+    double left = vertices.front().position.x;
+    double right = vertices.back().position.x;
+    EXPECT_NEAR(0.5 * (left + right), 100, 0.5 * 20);
+    // Doubling the size doubles the width and the outline adds a copy
+    batch.clear();
+    batch.add_text("12", Vec2(100, 100), 40, sf::Color::White,
+                   sf::Color::Black);
+    ASSERT_EQ(batch.vertices().size(), 24);
+    double double_width =
+        batch.vertices().back().position.x - batch.vertices()[12].position.x;
+    EXPECT_NEAR(double_width, 2 * (right - left), 1e-3);
+}
+
+}  // namespace
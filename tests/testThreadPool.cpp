@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <vvipers/Utilities/ThreadPool.hpp>
+
+using namespace VVipers;
+
+namespace {
+
+TEST(ThreadPoolTest, ParallelForTest) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.size(), 3u);
+    std::vector<int> calls(1000, 0);
+    // Run it several times to make sure the workers are woken up again
+    for (int round = 0; round < 10; ++round)
+        pool.parallel_for(calls.size(), [&](size_t index) { ++calls[index]; });
+    for (auto number_of_calls : calls)
+        EXPECT_EQ(number_of_calls, 10);
+}
+
+TEST(ThreadPoolTest, NoWorkersTest) {
+    ThreadPool pool(0);
+    std::atomic<size_t> sum = 0;
+    pool.parallel_for(100, [&](size_t index) { sum += index; });
+    EXPECT_EQ(sum, 4950u);
+}
+
+TEST(ThreadPoolTest, ExceptionTest) {
+    ThreadPool pool(2);
+    std::atomic<int> calls = 0;
+    EXPECT_THROW(pool.parallel_for(10,
+                                   [&](size_t index) {
+                                       ++calls;
+                                       if (index == 5)
+                                           throw std::runtime_error("Task");
+                                   }),
+                 std::runtime_error);
+    // The remaining tasks still run
+    EXPECT_EQ(calls, 10);
+    pool.parallel_for(10, [&](size_t) { ++calls; });
+    EXPECT_EQ(calls, 20);
+}
+
+}  // namespace
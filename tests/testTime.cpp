@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <sstream>
 #include <thread>
+#include <vvipers/Utilities/FramePacer.hpp>
+#include <vvipers/Utilities/FrameStatistics.hpp>
+#include <vvipers/Utilities/Profiler.hpp>
 #include <vvipers/Utilities/Time.hpp>
 
 using namespace VVipers;
@@ -30,4 +34,79 @@ TEST(TimeTest, StopwatchTest) {
     EXPECT_THROW(clock.stop(), std::logic_error);
 }
 
+TEST(TimeTest, FramePacerTest) {
+    FramePacer pacer(time_from_seconds(0.01));
+    Stopwatch clock;
+    clock.start();
+    for (int i = 0; i < 10; ++i) {
+        // Work of varying length is evened out
+        std::this_thread::sleep_for(std::chrono::milliseconds(i % 3));
+        pacer.wait_for_next_frame();
+    }
+    auto duration = clock.stop();
+    EXPECT_GE(time_as_seconds(duration), 0.1);
+    EXPECT_NEAR(time_as_seconds(duration), 0.1, 0.01);
+    EXPECT_EQ(pacer.statistics().frames, 10);
+    EXPECT_GE(pacer.last_error(), Time(0));
+    // A long frame is not caught up with
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    pacer.wait_for_next_frame();
+    clock.start();
+    pacer.wait_for_next_frame();
+    EXPECT_NEAR(time_as_seconds(clock.stop()), 0.01, 0.005);
+}
+
+TEST(TimeTest, FrameStatisticsTest) {
+    FrameStatistics statistics(100);
+    auto frame = [](double ms) {
+        FrameStatistics::Timings timings;
+        timings.fill(Time(0));
+        timings[FrameStatistics::Frame] = time_from_seconds(ms / 1000);
+        return timings;
+    };
+    // The first frames fall out of the buffer
+    for (int i = 0; i < 50; ++i)
+        statistics.add(frame(1000));
+    for (int i = 1; i <= 100; ++i)
+        statistics.add(frame(i));
+    EXPECT_EQ(statistics.size(), 100);
+    EXPECT_NEAR(time_as_seconds(statistics.timings()[FrameStatistics::Frame]),
+                0.1, 1e-9);
+    EXPECT_NEAR(
+        time_as_seconds(statistics.timings(99)[FrameStatistics::Frame]), 0.001,
+        1e-9);
+    EXPECT_NEAR(time_as_seconds(statistics.mean(FrameStatistics::Frame)),
+                0.0505, 1e-9);
+    EXPECT_NEAR(
+        time_as_seconds(statistics.percentile(FrameStatistics::Frame, 0.5)),
+        0.050, 1e-9);
+    EXPECT_NEAR(
+        time_as_seconds(statistics.percentile(FrameStatistics::Frame, 0.95)),
+        0.095, 1e-9);
+    EXPECT_NEAR(
+        time_as_seconds(statistics.percentile(FrameStatistics::Frame, 0.99)),
+        0.099, 1e-9);
+    EXPECT_THROW(statistics.timings(100), std::out_of_range);
+}
+
+TEST(TimeTest, ProfilerTest) {
+    // Empties the buffers
+    std::stringstream ignored;
+    Profiler::write_chrome_trace(ignored);
+    {
+        ProfileZone outer("Outer \"zone\"");
+        std::thread([] { ProfileZone inner("Other thread"); }).join();
+    }
+    std::stringstream trace;
+    Profiler::write_chrome_trace(trace);
+    std::string json = trace.str();
+    EXPECT_NE(json.find("\"name\":\"Outer \\\"zone\\\"\""),
+              std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Other thread\""), std::string::npos);
+    // Written zones are not written again
+    std::stringstream empty;
+    Profiler::write_chrome_trace(empty);
+    EXPECT_EQ(empty.str().find("\"name\""), std::string::npos);
+}
+
 }  // namespace
\ No newline at end of file
@@ -119,4 +119,111 @@ TEST_F(TrackTest, SearchTest) {
               track->begin() + 1);
 }
 
+class CompactTrackTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        track = std::unique_ptr<CompactTemporalTrack>(new CompactTemporalTrack(
+            Vec2(1, 4), time_from_seconds(-3), Vec2(2, 4), time_from_seconds(-4)));
+        track->create_front(Vec2(0, -1), time_from_seconds(1.));
+        track->create_front(Vec2(0, -1), time_from_seconds(1.));
+        track->create_front(Vec2(0, -1), time_from_seconds(1.));
+        track->create_front(Vec2(0, -1. / 3.), time_from_seconds(3.));
+        track->create_front(Vec2(-1. / 2., 0), time_from_seconds(2.));
+    }
+    std::unique_ptr<CompactTemporalTrack> track;
+};
+
+TEST_F(CompactTrackTest, StorageSizeTest) {
+    EXPECT_LE(2 * sizeof(CompactTemporalTrackPoint),
+              sizeof(TemporalTrackPoint));
+}
+
+TEST_F(CompactTrackTest, LengthTest) {
+    EXPECT_NEAR(track->length(), 6, 1e-5);
+    EXPECT_NEAR(track->length(time_from_seconds(5), time_from_seconds(2)),
+                1 + 1 / 3., 1e-5);
+    EXPECT_THROW(track->length(time_from_seconds(0), time_from_seconds(4)),
+                 std::runtime_error);
+}
+
+TEST_F(CompactTrackTest, PositionTest) {
+    EXPECT_NEAR(distance(track->position(time_from_seconds(0)), Vec2(1, 1)), 0,
+                1e-5);
+    EXPECT_NEAR(
+        distance(track->position(time_from_seconds(2)), Vec2(1, 1. / 3.)), 0,
+        1e-5);
+    EXPECT_NEAR(distance(track->position(time_from_seconds(5)), Vec2(0, 0)), 0,
+                1e-5);
+    EXPECT_NEAR(distance(track->velocity(time_from_seconds(3)).normalized(),
+                         Vec2(-1, 0)),
+                0, 1e-5);
+}
+
+TEST_F(CompactTrackTest, SearchTest) {
+    EXPECT_EQ(track->decode(*track->at_or_before(time_from_seconds(3.5)))
+                  .spawn_time,
+              time_from_seconds(3.));
+    EXPECT_EQ(track->decode(*track->at_or_later(time_from_seconds(2.5)))
+                  .spawn_time,
+              time_from_seconds(3.));
+    EXPECT_EQ(track->at_or_later(time_from_seconds(10.)), track->end());
+}
+
+TEST(CompactTrackPrecisionTest, SubPixelTest) {
+    // A viper circling a large arena for an hour, far from the track origin
+    const double fps = 60;
+    const Time dt = time_from_seconds(1. / fps);
+    const Vec2 center(2000, 1500);
+    const double radius = 1000;
+    const double speed = 200;
+    auto position_at = [&](double t) {
+        return center + Vec2(radius, 0).rotate(speed * t / radius);
+    };
+    TemporalTrack full(position_at(0), time_from_seconds(0), position_at(-1),
+                       time_from_seconds(-1));
+    CompactTemporalTrack compact(position_at(0), time_from_seconds(0),
+                                 position_at(-1), time_from_seconds(-1));
+    for (int frame = 1; frame <= 3600 * fps; ++frame) {
+        auto t = frame / fps;
+        Vec2 v = (position_at(t) - position_at(t - 1. / fps)) * fps;
+        full.create_front(v, dt);
+        compact.create_front(v, dt);
+        full.remove_trailing(time_from_seconds(t - 10));
+        compact.remove_trailing(time_from_seconds(t - 10));
+    }
+    for (double t = 3600 - 9.5; t < 3600; t += 0.123) {
+        EXPECT_LT(distance(full.position(time_from_seconds(t)),
+                           compact.position(time_from_seconds(t))),
+                  0.5);
+    }
+}
+
+TEST(TrackIndexTest, IndexedSearchTest) {
+    // Irregular frame times, some shorter and some longer than a bucket
+    const Time deltas[] = {time_from_seconds(0.004), time_from_seconds(0.016),
+                           time_from_seconds(0.017), time_from_seconds(0.1)};
+    TemporalTrack track(Vec2(0, 0), time_from_seconds(0), Vec2(-1, 0),
+                        time_from_seconds(-1));
+    Time now = time_from_seconds(0);
+    for (int frame = 1; frame <= 2000; ++frame) {
+        auto delta = deltas[(frame * 7) % 4];
+        now += delta;
+        track.create_front(Vec2(1, 0), delta);
+        track.remove_trailing(now - time_from_seconds(3));
+    }
+    for (auto t = now - time_from_seconds(4); t < now + time_from_seconds(1);
+         t += time_from_seconds(0.0037)) {
+        EXPECT_EQ(track.at_or_before(t),
+                  track.at_or_before(t, track.begin(), track.end()));
+        EXPECT_EQ(track.at_or_later(t),
+                  track.at_or_later(t, track.begin(), track.end()));
+    }
+    for (const auto& point : track) {
+        EXPECT_EQ(track.at_or_before(point.spawn_time)->spawn_time,
+                  point.spawn_time);
+        EXPECT_EQ(track.at_or_later(point.spawn_time)->spawn_time,
+                  point.spawn_time);
+    }
+}
+
 }  // namespace
\ No newline at end of file
@@ -1,15 +1,31 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <memory>
 #include <vvipers/Engine/OptionsJSON.hpp>
 #include <vvipers/Engine/TextureFileLoader.hpp>
 #include <vvipers/Utilities/Time.hpp>
+#include <vvipers/Utilities/VVColor.hpp>
 #include <vvipers/GameElements/Viper.hpp>
+#include <vvipers/GameElements/ViperBatch.hpp>
 #include <vvipers/config.hpp>
 #include <vvipers/Utilities/debug.hpp>
 
 using namespace VVipers;
 
+namespace VVipers {
+struct ViperTestAccess {
+    static sf::Color vertex_color(Viper& viper, Time time) {
+        return viper.calculate_vertex_color(time);
+    }
+    static std::vector<sf::Vertex>& body_vertices(Viper& viper) {
+        return viper._triangle_strip_body.vertices;
+    }
+};
+}  // namespace VVipers
+
 namespace {
 
 class ViperTest : public ::testing::Test {
@@ -20,13 +36,14 @@ class ViperTest : public ::testing::Test {
         const std::string resPathOptStr("General/resourceDirectoryPath");
         if (!options->is_option_set(resPathOptStr))
             options->set_option_string(resPathOptStr, RESOURCE_PATH);
-        auto textures = std::make_unique<TextureFileLoader>(*options.get());
+        textures = std::make_unique<TextureFileLoader>(*options.get());
         auto viper_cfg = std::make_shared<ViperConfiguration>(*options, *textures);
         viper = std::make_unique<Viper>(viper_cfg,Vec2(0, 0), 0.f, 1.5);
     }
 
     std::unique_ptr<Viper> viper;
     std::unique_ptr<OptionsJSON> options;
+    std::unique_ptr<TextureFileLoader> textures;
 };
 
 TEST_F(ViperTest, angleTest) {
@@ -55,4 +72,373 @@ TEST_F(ViperTest, lengthTest) {
     EXPECT_DOUBLE_EQ(viper->length(), expectedLength);
 }
 
+TEST_F(ViperTest, dinnerGrowthTest) {
+    viper->update(time_from_seconds(3.0));  // Let it grow
+    auto temporal_length = viper->temporal_length();
+    auto body_duration = viper->viper_configuration().body_duration;
+    auto now = viper->temporal_track().head_time();
+    // Added out of order, the same time twice replaces the first dinner
+    viper->add_growth(body_duration, now, sf::Color::Red);
+    viper->add_growth(2 * body_duration, now - 0.1 * body_duration,
+                      sf::Color::Green);
+    viper->add_growth(0.5 * body_duration, now, sf::Color::Blue);
+    for (int frame = 0; frame < 600; ++frame)
+        viper->update(time_from_seconds(1. / 60));
+    EXPECT_NEAR(time_as_seconds(viper->temporal_length()),
+                time_as_seconds(temporal_length + 2.5 * body_duration), 1e-9);
+}
+
+TEST_F(ViperTest, dinnerColorTest) {
+    // The dinner lookup as it was done with a std::map and lower_bound
+    struct Dinner {
+        Time amount;
+        sf::Color color;
+    };
+    std::map<Time, Dinner> dinners;
+    auto reference_color = [&](Time time) {
+        auto head_side = dinners.lower_bound(time);
+        auto tail_side = head_side != dinners.begin() ? std::prev(head_side)
+                                                       : dinners.end();
+        auto factor = [&](auto side, sf::Color& color) {
+            if (side == dinners.end())
+                return 0.;
+            Time half_length = side->second.amount;
+            Time distance =
+                std::chrono::abs(time - (side->first + 0.5 * half_length));
+            if (distance >= 0.5 * half_length)
+                return 0.;
+            color = side->second.color;
+            return 1. - distance / half_length;
+        };
+        sf::Color color1 = sf::Color::Transparent;
+        sf::Color color2 = sf::Color::Transparent;
+        double factor1 = factor(tail_side, color1);
+        double factor2 = factor(head_side, color2);
+        double sum = factor1 + factor2;
+        if (sum > 1) {
+            factor1 /= sum;
+            factor2 /= sum;
+        }
+        return blend_colors(viper->primary_color(), 1. - sum,
+                            blend_colors(color1, factor1, color2, factor2),
+                            sum);
+    };
+    auto add_growth = [&](double amount, double when, sf::Color color) {
+        viper->add_growth(time_from_seconds(amount), time_from_seconds(when),
+                          color);
+        dinners[time_from_seconds(when)] = {time_from_seconds(amount), color};
+    };
+    // Out of order and overlapping, the same time twice replaces the first
+    add_growth(0.4, 2.0, sf::Color::Red);
+    add_growth(0.6, 1.0, sf::Color::Green);
+    add_growth(0.5, 1.3, sf::Color::Yellow);
+    add_growth(0.2, 3.0, sf::Color::Cyan);
+    add_growth(0.3, 2.0, sf::Color::Blue);
+
+    auto expect_same_color = [&](double seconds) {
+        Time time = time_from_seconds(seconds);
+        EXPECT_EQ(ViperTestAccess::vertex_color(*viper, time),
+                  reference_color(time))
+            << "at " << seconds << " s";
+    };
+    // Backwards like the mesh, forwards, and jumping back and forth
+    for (double t = 3.5; t > 0.5; t -= 0.01)
+        expect_same_color(t);
+    for (double t = 0.5; t < 3.5; t += 0.01)
+        expect_same_color(t);
+    for (double t : {0.9, 3.1, 1.1, 2.9, 1.3, 1.3, 0.5, 2.0, 2.0, 1.0, 3.0})
+        expect_same_color(t);
+    // The middle of the replacing dinner has its color
+    EXPECT_EQ(ViperTestAccess::vertex_color(*viper, time_from_seconds(2.15)),
+              sf::Color::Blue);
+}
+
+TEST_F(ViperTest, deferredNotificationTest) {
+    struct EventCounter : public Observer {
+        void on_notify(const GameEvent&) override { ++events; }
+        int events = 0;
+    } counter;
+    viper->add_observer(&counter, {GameEvent::EventType::ObjectModified});
+    viper->defer_notifications(true);
+    viper->add_boost_charge(time_from_seconds(-1.));
+    viper->add_boost_charge(time_from_seconds(0.5));
+    EXPECT_EQ(counter.events, 0);
+    viper->defer_notifications(false);
+    viper->flush_notifications();
+    EXPECT_EQ(counter.events, 2);
+    viper->flush_notifications();
+    EXPECT_EQ(counter.events, 2);
+}
+
+TEST_F(ViperTest, reduceNodesTest) {
+    const auto& viper_cfg = viper->viper_configuration();
+    auto nodes = ViperConfiguration::reduce_nodes(viper_cfg.body_nodes, 4);
+    ASSERT_EQ(nodes.size(), 4u);
+    EXPECT_EQ(nodes.front(), viper_cfg.body_nodes.front());
+    EXPECT_EQ(nodes.back(), viper_cfg.body_nodes.back());
+    EXPECT_EQ(viper_cfg.body_node_levels[0], viper_cfg.body_nodes);
+    EXPECT_EQ(ViperConfiguration::reduce_nodes(viper_cfg.tail_nodes, 1).size(),
+              3u);
+}
+
+TEST_F(ViperTest, nodeTableTest) {
+    const auto& viper_cfg = viper->viper_configuration();
+    for (size_t level = 0; level < ViperConfiguration::number_of_detail_levels;
+         ++level) {
+        const auto& nodes = viper_cfg.body_node_levels[level];
+        const auto& table = viper_cfg.body_node_tables[level];
+        ASSERT_EQ(table.size(), nodes.size());
+        const auto& area = viper_cfg.body_texture_rect;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            EXPECT_DOUBLE_EQ(table.time_fraction[i], nodes[i].y);
+            EXPECT_DOUBLE_EQ(table.width_factor[i],
+                             viper_cfg.nominal_speed *
+                                 viper_cfg.nominal_segment_width * nodes[i].x);
+            EXPECT_FLOAT_EQ(table.texture_u_left[i] + table.texture_u_right[i],
+                            2 * area.left + area.width);
+        }
+    }
+}
+
+TEST_F(ViperTest, textureAtlasTest) {
+    const auto& viper_cfg = viper->viper_configuration();
+    // All parts share one texture, which lets the vipers be drawn at once
+    EXPECT_EQ(viper_cfg.head_texture, viper_cfg.body_texture);
+    EXPECT_EQ(viper_cfg.body_texture, viper_cfg.tail_texture);
+    const auto& atlas = *viper_cfg.body_texture;
+    for (const auto& area : {viper_cfg.head_texture_rect,
+                             viper_cfg.body_texture_rect,
+                             viper_cfg.tail_texture_rect}) {
+        EXPECT_GE(area.left, 0);
+        EXPECT_LE(area.left + area.width, int(atlas.getSize().x));
+        EXPECT_LE(area.top + area.height, int(atlas.getSize().y));
+    }
+    EXPECT_FALSE(viper_cfg.head_texture_rect.intersects(
+        viper_cfg.body_texture_rect));
+    EXPECT_FALSE(viper_cfg.body_texture_rect.intersects(
+        viper_cfg.tail_texture_rect));
+    // The repeated body wraps vertically onto itself
+    EXPECT_TRUE(atlas.isRepeated());
+    EXPECT_EQ(viper_cfg.body_texture_rect.height, int(atlas.getSize().y));
+}
+
+TEST_F(ViperTest, detailLevelTest) {
+    auto count_corners = [](const Viper& viper) {
+        size_t number_of_corners = 0;
+        for (size_t i = 0; i < viper.number_of_segments(); ++i)
+            number_of_corners +=
+                static_cast<const Polygon&>(*viper.segment_shape(i))
+                    .corners()
+                    .size();
+        return number_of_corners;
+    };
+    viper->update(time_from_seconds(3.0));  // Let it grow
+    auto number_of_segments = viper->number_of_segments();
+    auto full_detail = count_corners(*viper);
+    EXPECT_LT(viper->estimated_vertex_count(2),
+              viper->estimated_vertex_count(0));
+    viper->set_detail_level(2);
+    viper->update(time_from_seconds(1. / 60));
+    EXPECT_EQ(viper->number_of_segments(), number_of_segments);
+    EXPECT_LT(count_corners(*viper), full_detail);
+    EXPECT_EQ(viper->detail_level(), 2u);
+}
+
+TEST_F(ViperTest, incrementalMeshTest) {
+    auto viper_cfg =
+        std::make_shared<ViperConfiguration>(viper->viper_configuration());
+    viper_cfg->incremental_mesh = true;
+    Viper incremental(viper_cfg, Vec2(0, 0), 0., 5.5);
+    Viper rebuilt(viper_cfg, Vec2(0, 0), 0., 5.5);
+    for (int frame = 0; frame < 600; ++frame) {
+        double angular_speed = frame % 200 < 100 ? 30. : -45.;
+        incremental.steer(angular_speed, 0.);
+        rebuilt.steer(angular_speed, 0.);
+        // Setting the colors makes the viper rebuild the whole mesh
+        rebuilt.set_colors(rebuilt.primary_color(), rebuilt.secondary_color());
+        incremental.update(time_from_seconds(1. / 60));
+        rebuilt.update(time_from_seconds(1. / 60));
+        ASSERT_EQ(incremental.number_of_segments(),
+                  rebuilt.number_of_segments());
+        for (size_t i = 0; i < incremental.number_of_segments(); ++i) {
+            EXPECT_EQ(static_cast<const Polygon&>(*incremental.segment_shape(i))
+                          .corners(),
+                      static_cast<const Polygon&>(*rebuilt.segment_shape(i))
+                          .corners());
+        }
+    }
+    EXPECT_GT(incremental.number_of_segments(), 6u);
+}
+
+TEST_F(ViperTest, incrementalMeshLegacyTest) {
+    // Durations exact in binary, so that the body starts on the segment grid
+    // of the incremental mesh every eighth frame. The meshes agree then, apart
+    // from the texture coordinates, which are offset by whole textures.
+    auto legacy_cfg =
+        std::make_shared<ViperConfiguration>(viper->viper_configuration());
+    legacy_cfg->incremental_mesh = false;
+    legacy_cfg->head_duration = time_from_seconds(0.0625);
+    legacy_cfg->body_duration = time_from_seconds(0.125);
+    legacy_cfg->tail_duration = time_from_seconds(0.0625);
+    auto incremental_cfg = std::make_shared<ViperConfiguration>(*legacy_cfg);
+    incremental_cfg->incremental_mesh = true;
+    Viper legacy(legacy_cfg, Vec2(0, 0), 0., 5.5);
+    Viper incremental(incremental_cfg, Vec2(0, 0), 0., 5.5);
+    legacy.add_growth(time_from_seconds(0.5), time_from_seconds(0.2),
+                      sf::Color::Blue);
+    incremental.add_growth(time_from_seconds(0.5), time_from_seconds(0.2),
+                           sf::Color::Blue);
+
+    auto all_vertices = [](const Viper& viper) {
+        std::vector<sf::Vertex> vertices;
+        viper.visible_strips(
+            BoundingBox(-1e6, 1e6, -1e6, 1e6),
+            [&](const TriangleStripArray& strip, size_t begin, size_t end) {
+                vertices.insert(vertices.end(), strip.vertices.begin() + begin,
+                                strip.vertices.begin() + end);
+            });
+        return vertices;
+    };
+    const Time grid = incremental_cfg->body_duration;
+    int compared_frames = 0;
+    for (int frame = 0; frame < 600; ++frame) {
+        double angular_speed = frame % 200 < 100 ? 30. : -45.;
+        legacy.steer(angular_speed, 0.);
+        incremental.steer(angular_speed, 0.);
+        legacy.update(time_from_seconds(1. / 64));
+        incremental.update(time_from_seconds(1. / 64));
+        Time body_start = incremental.temporal_track().head_time() -
+                          incremental_cfg->head_duration;
+        Time body_duration = incremental.temporal_length() -
+                             incremental_cfg->head_duration -
+                             incremental_cfg->tail_duration;
+        // The legacy mesh ends a body of whole segments with an empty one
+        if (std::fmod(body_start / grid, 1.) != 0 ||
+            std::fmod(body_duration / grid, 1.) == 0)
+            continue;
+        ++compared_frames;
+        ASSERT_EQ(incremental.number_of_segments(),
+                  legacy.number_of_segments());
+        for (size_t i = 0; i < legacy.number_of_segments(); ++i)
+            EXPECT_EQ(static_cast<const Polygon&>(*incremental.segment_shape(i))
+                          .corners(),
+                      static_cast<const Polygon&>(*legacy.segment_shape(i))
+                          .corners());
+        auto legacy_vertices = all_vertices(legacy);
+        auto incremental_vertices = all_vertices(incremental);
+        ASSERT_EQ(incremental_vertices.size(), legacy_vertices.size());
+        for (size_t i = 0; i < legacy_vertices.size(); ++i) {
+            EXPECT_EQ(incremental_vertices[i].position,
+                      legacy_vertices[i].position);
+            EXPECT_EQ(incremental_vertices[i].color, legacy_vertices[i].color);
+        }
+    }
+    EXPECT_GT(compared_frames, 50);
+    EXPECT_GT(incremental.number_of_segments(), 6u);
+}
+
+TEST_F(ViperTest, incrementalMeshCostTest) {
+    // Marks the whole body strip before each update and counts the visible
+    // body vertices the update wrote, which must not grow with the length
+    auto viper_cfg =
+        std::make_shared<ViperConfiguration>(viper->viper_configuration());
+    viper_cfg->incremental_mesh = true;
+    Viper long_viper(viper_cfg, Vec2(0, 0), 0., 200.);
+    long_viper.update(201 * viper_cfg->body_duration);
+    ASSERT_GT(long_viper.number_of_segments(), 200u);
+    const sf::Color mark(1, 2, 3, 4);
+    auto& body_vertices = ViperTestAccess::body_vertices(long_viper);
+    size_t most_written = 0;
+    for (int frame = 0; frame < 120; ++frame) {
+        for (auto& vertex : body_vertices)
+            vertex.color = mark;
+        long_viper.steer(frame % 60 < 30 ? 30. : -45., 0.);
+        long_viper.update(time_from_seconds(1. / 60));
+        size_t written = 0;
+        long_viper.visible_strips(
+            BoundingBox(-1e6, 1e6, -1e6, 1e6),
+            [&](const TriangleStripArray& strip, size_t begin, size_t end) {
+                if (&strip.vertices == &body_vertices)
+                    written += std::count_if(
+                        strip.vertices.begin() + begin,
+                        strip.vertices.begin() + end,
+                        [&](const sf::Vertex& v) { return v.color != mark; });
+            });
+        most_written = std::max(most_written, written);
+    }
+    // The two partial segments and a new one
+    size_t segment_vertices = 2 * viper_cfg->body_node_tables[0].size();
+    EXPECT_GT(most_written, 0u);
+    EXPECT_LE(most_written, 3 * segment_vertices);
+}
+
+TEST_F(ViperTest, capsuleCollisionTest) {
+    auto polygon_cfg =
+        std::make_shared<ViperConfiguration>(viper->viper_configuration());
+    auto capsule_cfg = std::make_shared<ViperConfiguration>(*polygon_cfg);
+    capsule_cfg->capsule_collision = true;
+    Viper polygons(polygon_cfg, Vec2(0, 0), 0., 5.5);
+    Viper capsules(capsule_cfg, Vec2(0, 0), 0., 5.5);
+    for (int frame = 0; frame < 300; ++frame) {
+        double angular_speed = frame % 200 < 100 ? 0.3 : -0.45;
+        polygons.steer(angular_speed, 0.);
+        capsules.steer(angular_speed, 0.);
+        polygons.update(time_from_seconds(1. / 60));
+        capsules.update(time_from_seconds(1. / 60));
+    }
+    ASSERT_EQ(capsules.number_of_segments(), polygons.number_of_segments());
+    for (size_t i = 0; i < capsules.number_of_segments(); ++i) {
+        ASSERT_EQ(capsules.segment_shape(i)->type(), ShapeType::Capsule);
+        EXPECT_TRUE(
+            capsules.segment_shape(i)->overlap(*polygons.segment_shape(i)));
+    }
+    // Neighbours touch but the head does not reach the rest of the body
+    EXPECT_TRUE(capsules.segment_shape(0)->overlap(*capsules.segment_shape(1)));
+    EXPECT_FALSE(
+        capsules.segment_shape(0)->overlap(*capsules.segment_shape(3)));
+}
+
+TEST_F(ViperTest, sweptHeadTest) {
+    auto start = viper->temporal_track().head_position();
+    viper->update(time_from_seconds(0.5));
+    auto swept_head = viper->swept_head();
+    EXPECT_EQ(swept_head.start(), start);
+    EXPECT_EQ(swept_head.end(), viper->temporal_track().head_position());
+    EXPECT_NEAR(distance(swept_head.start(), swept_head.end()),
+                0.5 * viper->speed(), 1.);
+}
+
+TEST_F(ViperTest, batchTest) {
+    auto viper_cfg =
+        std::make_shared<ViperConfiguration>(viper->viper_configuration());
+    Viper other(viper_cfg, Vec2(0, 100), 0., 3.5);
+    viper->update(time_from_seconds(0.5));
+    other.update(time_from_seconds(0.5));
+    ViperBatch batch;
+    BoundingBox everywhere(-1e4, 1e4, -1e4, 1e4);
+    batch.pack({viper.get(), &other}, everywhere);
+    // The head, body and tail share a texture atlas
+    size_t number_of_strips = 0, number_of_vertices = 0;
+    for (auto v : {viper.get(), &other})
+        v->visible_strips(everywhere, [&](const TriangleStripArray& strip,
+                                          size_t begin, size_t end) {
+            ++number_of_strips;
+            number_of_vertices += end - begin;
+        });
+    size_t packed_vertices = 0;
+    for (size_t i = 0; i < batch.number_of_batches(); ++i)
+        packed_vertices += batch.batch_vertices(i).size();
+    // Two degenerate vertices join each strip to the one before it
+    EXPECT_EQ(packed_vertices,
+              number_of_vertices +
+                  2 * (number_of_strips - batch.number_of_batches()));
+    EXPECT_EQ(batch.number_of_batches(), 1u);
+    // Far away the bodies are culled
+    batch.pack({viper.get(), &other}, BoundingBox(1e4, 2e4, 1e4, 2e4));
+    size_t culled_vertices = 0;
+    for (size_t i = 0; i < batch.number_of_batches(); ++i)
+        culled_vertices += batch.batch_vertices(i).size();
+    EXPECT_LT(culled_vertices, packed_vertices);
+}
+
 }  // namespace
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+#include <vvipers/GameElements/Walls.hpp>
+#include <vvipers/Utilities/Shape.hpp>
+#include <vvipers/Utilities/Vec2.hpp>
+
+namespace {
+using namespace VVipers;
+
+// Every wall piece is a quad, drawn as two triangles in the order of the
+// polygons, and all pieces share the missing texture
+void expect_polygon_triangles(const Walls& walls) {
+    ASSERT_EQ(walls.static_ranges().size(), 1u);
+    const auto& range = walls.static_ranges()[0];
+    EXPECT_EQ(range.texture, nullptr);
+    EXPECT_EQ(range.first, 0u);
+    ASSERT_EQ(range.count, 6 * walls.number_of_segments());
+    ASSERT_EQ(walls.static_vertices().size(), range.count);
+    for (size_t i = 0; i < walls.number_of_segments(); ++i) {
+        auto polygon =
+            std::dynamic_pointer_cast<const Polygon>(walls.segment_shape(i));
+        ASSERT_TRUE(polygon);
+        std::vector<Vec2> corners = polygon->corners();
+        std::vector<Vec2> used;
+        for (size_t j = 6 * i; j < 6 * i + 6; ++j) {
+            Vec2 position = walls.static_vertices()[j].position;
+            EXPECT_NE(std::ranges::find(corners, position), corners.end());
+            if (std::ranges::find(used, position) == used.end())
+                used.push_back(position);
+        }
+        EXPECT_EQ(used.size(), corners.size());
+    }
+}
+
+TEST(WallsTest, StaticGeometryTest) {
+    Walls walls(Vec2(640, 480));
+    EXPECT_EQ(walls.uses_static_buffer(), sf::VertexBuffer::isAvailable());
+    expect_polygon_triangles(walls);
+}
+
+TEST(WallsTest, MemoryFallbackTest) {
+    // As when headless or without vertex buffers
+    Walls walls(Vec2(640, 480), false);
+    EXPECT_FALSE(walls.uses_static_buffer());
+    // The same vertices are drawn, only from memory
+    expect_polygon_triangles(walls);
+}
+
+}  // namespace
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <vvipers/Engine/HeadlessWindowManager.hpp>
+
+using namespace VVipers;
+
+namespace {
+
+sf::Event key_event(sf::Event::EventType type, sf::Keyboard::Scancode key) {
+    sf::Event event;
+    event.type = type;
+    event.key.scancode = key;
+    return event;
+}
+
+TEST(HeadlessWindowManagerTest, ScriptTest) {
+    HeadlessWindowManager window_manager(sf::Vector2u(800, 600));
+    // Holds the left key during the second frame
+    window_manager.set_input_script([](size_t frame, auto& window) {
+        if (frame == 1)
+            window.push_event(key_event(sf::Event::KeyPressed,
+                                        sf::Keyboard::Scan::Left));
+        else if (frame == 2)
+            window.push_event(key_event(sf::Event::KeyReleased,
+                                        sf::Keyboard::Scan::Left));
+    });
+    sf::Event event;
+    EXPECT_FALSE(window_manager.poll_event(event));
+    EXPECT_FALSE(window_manager.is_key_pressed(sf::Keyboard::Scan::Left));
+    ASSERT_TRUE(window_manager.poll_event(event));
+    EXPECT_EQ(event.type, sf::Event::KeyPressed);
+    EXPECT_TRUE(window_manager.is_key_pressed(sf::Keyboard::Scan::Left));
+    EXPECT_FALSE(window_manager.poll_event(event));
+    ASSERT_TRUE(window_manager.poll_event(event));
+    EXPECT_FALSE(window_manager.is_key_pressed(sf::Keyboard::Scan::Left));
+    EXPECT_FALSE(window_manager.poll_event(event));
+    EXPECT_EQ(window_manager.frame(), 3);
+}
+
+TEST(HeadlessWindowManagerTest, MouseTest) {
+    HeadlessWindowManager window_manager(sf::Vector2u(800, 600));
+    EXPECT_EQ(window_manager.mouse_position(), sf::Vector2i(400, 300));
+    sf::Event event;
+    event.type = sf::Event::MouseMoved;
+    event.mouseMove.x = 410;
+    event.mouseMove.y = 300;
+    window_manager.push_event(event);
+    ASSERT_TRUE(window_manager.poll_event(event));
+    EXPECT_EQ(window_manager.mouse_position(), sf::Vector2i(410, 300));
+    window_manager.center_mouse();
+    EXPECT_EQ(window_manager.mouse_position(), sf::Vector2i(400, 300));
+
+    // The right half of the window shows a 100 x 100 view
+    sf::View view(sf::FloatRect(0, 0, 100, 100));
+    view.setViewport(sf::FloatRect(0.5, 0, 0.5, 1));
+    EXPECT_EQ(window_manager.map_coordinates_to_pixel_values(Vec2(50, 50),
+                                                             view),
+              sf::Vector2i(600, 300));
+    Vec2 coordinates = window_manager.map_pixel_values_to_coordinates(
+        sf::Vector2i(700, 150), view);
+    EXPECT_NEAR(coordinates.x, 75, 1e-3);
+    EXPECT_NEAR(coordinates.y, 25, 1e-3);
+}
+
+}  // namespace
@@ -2,6 +2,7 @@
 
 #include <SFML/Graphics/Rect.hpp>
 #include <memory>
+#include <utility>
 #include <vvipers/Utilities/Vec2.hpp>
 
 #include "vvipers/Utilities/Shape.hpp"
@@ -15,6 +16,17 @@ class CollidingBody {
     virtual std::shared_ptr<const Shape> segment_shape(size_t index) const = 0;
     std::string name() const { return _name; }
     virtual size_t number_of_segments() const = 0;
+    /** Consecutive segments can be grouped into chunks with a common bounding
+     * box, which lets the CollisionManager reject them all at once. By
+     * default every segment is a chunk of its own. **/
+    virtual size_t number_of_chunks() const { return number_of_segments(); }
+    /** @returns the first and one past the last segment of the chunk **/
+    virtual std::pair<size_t, size_t> chunk_segments(size_t chunk) const {
+        return {chunk, chunk + 1};
+    }
+    virtual BoundingBox chunk_bounding_box(size_t chunk) const {
+        return segment_shape(chunk)->bounding_box();
+    }
     void set_name(const std::string& str) { _name = str; }
     bool operator==(const CollidingBody& other) const { return this == &other; }
 
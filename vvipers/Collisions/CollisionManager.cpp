@@ -5,47 +5,55 @@
 
 #include "vvipers/Collisions/CollidingBody.hpp"
 #include <vvipers/Collisions/CollisionManager.hpp>
+#include <vvipers/Utilities/Profiler.hpp>
 #include <vvipers/Utilities/debug.hpp>
 #include "vvipers/Utilities/Shape.hpp"
 
 namespace VVipers {
 
-struct CollisionEntity {
-  CollisionEntity(const CollidingBody* body, size_t body_part_index)
-    : index(body_part_index),
-      body(body),
-      shape(body->segment_shape(body_part_index)),
-      bounding_box(shape->bounding_box()) {}
-  const size_t index;
+// Consecutive segments of a body sharing a bounding box
+struct CollisionChunk {
   const CollidingBody* body;
-  const std::shared_ptr<const Shape> shape;
-  const BoundingBox bounding_box;
+  size_t index;
+  BoundingBox bounding_box;
 };
 
-void collision_check(
-  const std::vector<std::shared_ptr<const CollisionEntity>>& entities,
-  std::set<std::pair<CollisionItem, CollisionItem>>& all_collisions) {
-  for (const auto& [index, first_item] :
-       entities | std::ranges::views::enumerate) {
-    for (const auto& second_item : entities | std::views::drop(index + 1)) {
-      if (first_item->shape->overlap(*second_item->shape)) {
-        CollisionItem item1(first_item->body, first_item->index);
-        CollisionItem item2(second_item->body, second_item->index);
-        all_collisions.emplace(std::move(item1), std::move(item2));
-      }
+using ChunkPair = std::pair<const CollisionChunk*, const CollisionChunk*>;
+
+// The first segment of a body is its head
+bool contains_head(const CollisionChunk& chunk) {
+  return chunk.body->chunk_segments(chunk.index).first == 0;
+}
+
+// Chunks of the same body are paired only with the chunk of the head, which
+// then comes first
+void chunk_check(const std::vector<const CollisionChunk*>& chunks,
+                 std::set<ChunkPair>& chunk_pairs) {
+  for (const auto& [index, first_chunk] :
+       chunks | std::ranges::views::enumerate) {
+    for (const auto& second_chunk : chunks | std::views::drop(index + 1)) {
+      if (!first_chunk->bounding_box.overlap(second_chunk->bounding_box))
+        continue;
+      if (first_chunk->body != second_chunk->body)
+        chunk_pairs.emplace(std::min(first_chunk, second_chunk),
+                            std::max(first_chunk, second_chunk));
+      else if (contains_head(*first_chunk))
+        chunk_pairs.emplace(first_chunk, second_chunk);
+      else if (contains_head(*second_chunk))
+        chunk_pairs.emplace(second_chunk, first_chunk);
     }
   }
 }
 
-void collision_quad_tree(
-  const std::vector<std::shared_ptr<const CollisionEntity>>& entities,
-  const BoundingBox& area, size_t size_limit, double population_limit,
-  std::set<std::pair<CollisionItem, CollisionItem>>& all_collisions) {
+void collision_quad_tree(const std::vector<const CollisionChunk*>& chunks,
+                         const BoundingBox& area, size_t size_limit,
+                         double population_limit,
+                         std::set<ChunkPair>& chunk_pairs) {
   double x_mid = 0.5 * (area.x_max + area.x_min);
   double y_mid = 0.5 * (area.y_max + area.y_min);
   if (area.x_max - x_mid < size_limit || area.y_max - y_mid < size_limit ||
-      entities.size() <= population_limit) {
-    collision_check(entities, all_collisions);
+      chunks.size() <= population_limit) {
+    chunk_check(chunks, chunk_pairs);
     return;
   }
   BoundingBox bboxes[4] = {{area.x_min, x_mid, area.y_min, y_mid},
@@ -53,44 +61,108 @@ void collision_quad_tree(
                            {area.x_min, x_mid, y_mid, area.y_max},
                            {x_mid, area.x_max, y_mid, area.y_max}};
   for (auto quad : std::views::iota(0) | std::views::take(4)) {
-    std::vector<std::shared_ptr<const CollisionEntity>> quad_entities;
-    std::ranges::for_each(entities, [&](auto& entity) {
-      if (bboxes[quad].overlap(entity->bounding_box)) {
-        quad_entities.push_back(entity);
-      }
-      collision_quad_tree(quad_entities, bboxes[quad], size_limit,
-                          population_limit, all_collisions);
+    std::vector<const CollisionChunk*> quad_chunks;
+    std::ranges::for_each(chunks, [&](auto chunk) {
+      if (bboxes[quad].overlap(chunk->bounding_box))
+        quad_chunks.push_back(chunk);
     });
+    collision_quad_tree(quad_chunks, bboxes[quad], size_limit,
+                        population_limit, chunk_pairs);
   }
 }
 
-std::vector<std::shared_ptr<const CollisionEntity>> collect_collision_items(
+std::vector<CollisionChunk> collect_collision_chunks(
   const std::set<const CollidingBody*>& colliding_bodies) {
-  std::vector<std::shared_ptr<const CollisionEntity>> body_segments;
+  std::vector<CollisionChunk> chunks;
   std::ranges::for_each(colliding_bodies, [&](auto& body) {
     std::ranges::for_each(
-      std::views::iota(0) | std::views::take(body->number_of_segments()),
+      std::views::iota(size_t(0)) | std::views::take(body->number_of_chunks()),
       [&](auto i) {
-        body_segments.push_back(std::make_shared<CollisionEntity>(body, i));
+        chunks.push_back({body, i, body->chunk_bounding_box(i)});
       });
   });
-  return body_segments;
+  return chunks;
+}
+
+// Tests the segments of two chunks against each other. Within the same body
+// only the head, in the first chunk, is tested against the other segments.
+void segment_check(const CollisionChunk& first_chunk,
+                   const CollisionChunk& second_chunk,
+                   std::set<CollisionPair>& all_collisions) {
+  auto [first_begin, first_end] =
+    first_chunk.body->chunk_segments(first_chunk.index);
+  auto [second_begin, second_end] =
+    second_chunk.body->chunk_segments(second_chunk.index);
+  bool same_chunk = &first_chunk == &second_chunk;
+  if (first_chunk.body == second_chunk.body)
+    first_end = first_begin + 1;
+  for (size_t i = first_begin; i < first_end; ++i) {
+    auto first_shape = first_chunk.body->segment_shape(i);
+    for (size_t j = same_chunk ? i + 1 : second_begin; j < second_end; ++j) {
+      auto second_shape = second_chunk.body->segment_shape(j);
+      if (first_shape->overlap(*second_shape))
+        all_collisions.emplace(CollisionItem(first_chunk.body, i),
+                               CollisionItem(second_chunk.body, j));
+    }
+  }
 }
 
+/* The broad phase finds overlapping chunks in a quad tree, only the segments
+ * of those are tested against each other. A body only collides with itself
+ * at its head, so the head is always tested against the rest of its chunk
+ * and the other segments of a body never against each other. */
 std::set<CollisionPair> CollisionManager::check_for_collisions(
   const BoundingBox& starting_area) const {
-  auto collision_items = collect_collision_items(_colliding_bodies);
-  std::set<std::pair<CollisionItem, CollisionItem>> all_collisions;
-  collision_quad_tree(collision_items, starting_area, _size_limit,
-                      _population_limit, all_collisions);
+  PROFILE_ZONE("Collisions");
+  auto chunks = collect_collision_chunks(_colliding_bodies);
+  std::vector<const CollisionChunk*> chunk_pointers;
+  for (const auto& chunk : chunks)
+    chunk_pointers.push_back(&chunk);
+  std::set<ChunkPair> chunk_pairs;
+  {
+    PROFILE_ZONE("Broadphase");
+    collision_quad_tree(chunk_pointers, starting_area, _size_limit,
+                        _population_limit, chunk_pairs);
+  }
+
+  PROFILE_ZONE("Narrowphase");
+  std::set<CollisionPair> all_collisions;
+  for (const auto& chunk : chunks)
+    if (contains_head(chunk))
+      segment_check(chunk, chunk, all_collisions);
+  for (const auto& [first_chunk, second_chunk] : chunk_pairs)
+    segment_check(*first_chunk, *second_chunk, all_collisions);
   return all_collisions;
 }
 
+std::vector<CollisionItem> CollisionManager::find_overlapping(
+  const Shape& test_object) const {
+  PROFILE_FUNCTION();
+  std::vector<CollisionItem> overlapping;
+  auto test_box = test_object.bounding_box();
+  for (const auto& chunk : collect_collision_chunks(_colliding_bodies)) {
+    if (!test_box.overlap(chunk.bounding_box))
+      continue;
+    auto [begin, end] = chunk.body->chunk_segments(chunk.index);
+    for (size_t i = begin; i < end; ++i)
+      if (test_object.overlap(*chunk.body->segment_shape(i)))
+        overlapping.emplace_back(chunk.body, i);
+  }
+  return overlapping;
+}
+
 bool CollisionManager::is_occupied(const Shape& test_object) const {
-  auto collision_items = collect_collision_items(_colliding_bodies);
-  return std::ranges::any_of(collision_items, [&](auto& segment) {
-    return test_object.overlap(*segment->shape);
-  });
+  PROFILE_FUNCTION();
+  auto test_box = test_object.bounding_box();
+  for (const auto& chunk : collect_collision_chunks(_colliding_bodies)) {
+    if (!test_box.overlap(chunk.bounding_box))
+      continue;
+    auto [begin, end] = chunk.body->chunk_segments(chunk.index);
+    for (size_t i = begin; i < end; ++i)
+      if (test_object.overlap(*chunk.body->segment_shape(i)))
+        return true;
+  }
+  return false;
 }
 
 }  // namespace VVipers
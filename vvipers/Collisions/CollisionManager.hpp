@@ -1,6 +1,7 @@
 #pragma once
 
 #include <set>
+#include <vector>
 #include <vvipers/GameElements/GameObject.hpp>
 
 #include "vvipers/Collisions/CollidingBody.hpp"
@@ -24,12 +25,16 @@ class CollisionManager {
   public:
     CollisionManager(size_t population_limit, double size_limit)
         : _population_limit(population_limit), _size_limit(size_limit) {}
+    /** Only the first segment of a body, its head, is tested against the
+     * other segments of the same body **/
     std::set<CollisionPair> check_for_collisions(
         const BoundingBox& starting_area) const;
     void deregister_colliding_body(const CollidingBody* collider) {
         // If present remove it
         _colliding_bodies.erase(collider);
     }
+    /** @returns all registered segments overlapping the shape **/
+    std::vector<CollisionItem> find_overlapping(const Shape&) const;
     bool is_occupied(const Shape&) const;
     void register_colliding_body(const CollidingBody* collider) {
         _colliding_bodies.insert(collider);
@@ -1,10 +1,14 @@
 #include <SFML/Window/Event.hpp>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <stdexcept>
 #include <thread>
 #include <vector>
 #include <vvipers/Engine/Engine.hpp>
+#include <vvipers/Utilities/FramePacer.hpp>
+#include <vvipers/Utilities/Profiler.hpp>
 #include <vvipers/Utilities/Time.hpp>
 #include <vvipers/Utilities/Vec2.hpp>
 #include <vvipers/Utilities/debug.hpp>
@@ -13,8 +17,22 @@
 
 namespace VVipers {
 
+namespace {
+// Beyond this the game slows down instead of spending ever more time catching
+// up
+const int max_updates_per_frame = 5;
+// Shows or hides the frame statistics
+const auto frame_statistics_key = sf::Keyboard::Scan::F3;
+// Writes the profiling zones recorded since the last time
+const auto profile_key = sf::Keyboard::Scan::F4;
+}  // namespace
+
 Engine::Engine(std::unique_ptr<GameResources> game_resources)
-    : _game_resources(std::move(game_resources)) {}
+    : _game_resources(std::move(game_resources)),
+      _update_step(0),
+      _accumulated_time(0),
+      _vertical_sync(false),
+      _show_frame_statistics(false) {}
 
 void Engine::start_game() {
     double FPS =
@@ -30,19 +48,73 @@ void Engine::start_game() {
         }
     }
 
+    auto& options = _game_resources->options_service();
+    _vertical_sync = options.is_option_set("General/verticalSync") &&
+                     options.option_boolean("General/verticalSync");
+    _game_resources->window_manager().set_vertical_sync(_vertical_sync);
+    if (options.is_option_set("General/updateRate")) {
+        double update_rate = options.option_double("General/updateRate");
+        if (update_rate > 0)
+            _update_step = time_from_seconds(1. / update_rate);
+    }
+    // Without a window nothing is drawn
+    if (!_game_resources->is_headless()) {
+        if (options.is_option_set("General/renderThread") &&
+            options.option_boolean("General/renderThread"))
+            _render_thread = std::make_unique<RenderThread>(
+                _game_resources->window_manager());
+        _frame_statistics_scene = std::make_unique<FrameStatisticsScene>(
+            *_game_resources, _frame_statistics);
+    }
+
     game_loop(FPS);
+    _render_thread.reset();
+#ifdef PROFILING
+    write_profile();
+#endif
+}
+
+void Engine::write_profile() const {
+    auto& options = _game_resources->options_service();
+    std::filesystem::path base_name =
+        options.is_option_set("General/traceFile")
+            ? options.option_string("General/traceFile")
+            : "vvipers_trace.json";
+    // The first free one of name_1.json, name_2.json and so on
+    std::filesystem::path file_name;
+    for (int number = 1;; ++number) {
+        file_name = base_name;
+        file_name.replace_filename(base_name.stem().string() + "_" +
+                                   std::to_string(number) +
+                                   base_name.extension().string());
+        if (!std::filesystem::exists(file_name))
+            break;
+    }
+    std::ofstream file(file_name);
+    if (!file) {
+        log_error("Could not write the profile to ", file_name.string());
+        return;
+    }
+    Profiler::write_chrome_trace(file);
+    log_info("Wrote the profile to ", file_name.string());
+    if (Profiler::dropped_zones() > 0)
+        logWarning(Profiler::dropped_zones(),
+                   " profiling zones were dropped since the buffers were full");
 }
 
 void Engine::game_loop(double FPS) {
     Time tick_duration(0), update_duration(0), event_duration(0),
-        draw_duration(0), sleep_duration(0), debt_duration(0),
-        debug_duration(0);
-    const Time nominalFrameDuration = time_from_seconds(1. / FPS);
-    Time frameDuration = nominalFrameDuration;
-    double fpsAverage = 0.;
-    const size_t sampleSize = FPS;
-    std::vector<double> durationSamples(sampleSize, 0.);
-    size_t sampleIndex = 0;
+        draw_duration(0), wait_duration(0);
+    // Summaries are logged about once a second
+    const size_t frames_per_summary = std::max(1., FPS);
+    size_t frames_since_summary = 0;
+
+    const bool headless = _game_resources->is_headless();
+    const Time nominal_frame_duration = time_from_seconds(1. / FPS);
+    FramePacer pacer(nominal_frame_duration);
+    // Displaying waits for the screen instead, and without a screen the game
+    // runs as fast as it can
+    pacer.set_waiting(!_vertical_sync && !headless);
 
     Stopwatch clock;
     clock.start();
@@ -50,51 +122,77 @@ void Engine::game_loop(double FPS) {
     // Main game loop
     while (!_scenes.empty()) {
         tick_duration = clock.restart();
+        // Every frame takes the nominal time in the game, however long it took
+        // to compute, so that runs are repeatable
+        Time game_duration = headless ? nominal_frame_duration : tick_duration;
         // If not first tick
         if (!firstFrame) {
-            // Analyze last event
-            debt_duration = frameDuration - tick_duration;
-            frameDuration = nominalFrameDuration + debt_duration;
-            double fps = 1 / time_as_seconds(tick_duration);
-            // Calculate average FPS
-            durationSamples[sampleIndex++] = fps;
-            fpsAverage = 0.;
-            for (auto& t : durationSamples)
-                fpsAverage += t;
-            fpsAverage /= sampleSize;
-            if (sampleIndex == sampleSize)
-                sampleIndex = 0;
-            // Print some info
-            log_info("Last frame took ", tick_duration, " (on average ",
-                     fpsAverage, " FPS)");
-            log_info("  Debug:           ", debug_duration);
-            log_info("  Update:          ", update_duration);
-            log_info("  Events:          ", event_duration);
-            log_info("  Drawing:         ", draw_duration);
-            log_info("  Sleep:           ", sleep_duration);
-            log_info("  We owe the next frame: ", debt_duration);
+            _frame_statistics.add({tick_duration, update_duration,
+                                   event_duration, draw_duration,
+                                   wait_duration, pacer.last_error()});
+            if (++frames_since_summary == frames_per_summary) {
+                frames_since_summary = 0;
+                log_frame_statistics();
+                log_pacing_statistics(pacer);
+            }
+            if (_show_frame_statistics && _frame_statistics_scene)
+                _frame_statistics_scene->update(tick_duration);
         }
-        debug_duration = clock.split();
+        double interpolation = 1;
         if (!firstFrame) {
-            update(tick_duration);
+            if (_update_step > time_from_seconds(0))
+                interpolation = update_in_fixed_steps(game_duration);
+            else
+                update(game_duration);
         }
         update_duration = clock.split();
         process_window_events();
         event_duration = clock.split();
-        draw();
+        if (_scenes.empty())
+            break;
+        if (!headless) {
+            interpolate_scenes(interpolation);
+            if (_render_thread)
+                draw_pipelined();
+            else
+                draw();
+        }
         draw_duration = clock.split();
         process_scene_events();
 
-        sleep_duration =
-            std::max(time_from_seconds(0),
-                     frameDuration - (debug_duration + update_duration +
-                                      event_duration + draw_duration));
-        std::this_thread::sleep_for(sleep_duration);
+        {
+            PROFILE_ZONE("Wait");
+            pacer.wait_for_next_frame();
+        }
+        wait_duration = clock.split();
         firstFrame = false;
     }
 }
 
+void Engine::log_frame_statistics() const {
+    using Phase = FrameStatistics::Phase;
+    log_info("Average FPS: ",
+             1 / time_as_seconds(_frame_statistics.mean(Phase::Frame)));
+    for (int phase = 0; phase < Phase::NumberOfPhases; ++phase) {
+        auto p = Phase(phase);
+        log_info("  ", FrameStatistics::phase_name(p), ": mean ",
+                 _frame_statistics.mean(p), ", p50 ",
+                 _frame_statistics.percentile(p, 0.50), ", p95 ",
+                 _frame_statistics.percentile(p, 0.95), ", p99 ",
+                 _frame_statistics.percentile(p, 0.99));
+    }
+}
+
+void Engine::log_pacing_statistics(FramePacer& pacer) {
+    const auto& statistics = pacer.statistics();
+    log_info("Frame pacing over ", statistics.frames, " frames: mean error ",
+             statistics.mean_error, ", max error ", statistics.max_error,
+             ", ", statistics.late_frames, " late");
+    pacer.reset_statistics();
+}
+
 void Engine::update(const Time elapsed_time) {
+    PROFILE_ZONE("Update");
     for (auto& scene : _scenes) {
         if (scene->run_state() == Scene::RunState::Running) {
             scene->update(elapsed_time);
@@ -102,11 +200,42 @@ void Engine::update(const Time elapsed_time) {
     }
 }
 
+double Engine::update_in_fixed_steps(const Time elapsed_time) {
+    _accumulated_time += elapsed_time;
+    int steps = 0;
+    while (_accumulated_time >= _update_step) {
+        // The scenes must change before they are updated again, the time left
+        // is spent in the next frame
+        if (!_scene_events.empty())
+            break;
+        if (steps == max_updates_per_frame) {
+            _accumulated_time = time_from_seconds(
+                std::fmod(time_as_seconds(_accumulated_time),
+                          time_as_seconds(_update_step)));
+            break;
+        }
+        update(_update_step);
+        _accumulated_time -= _update_step;
+        ++steps;
+    }
+    return _accumulated_time / _update_step;
+}
+
+// Paused scenes are not updated, so they are shown as they were last updated
+void Engine::interpolate_scenes(double interpolation) {
+    for (auto scene : visible_scenes())
+        scene->interpolate(scene->run_state() == Scene::RunState::Running
+                               ? interpolation
+                               : 1);
+}
+
 void Engine::process_window_events() {
+    PROFILE_ZONE("Events");
     sf::Event event;
     while (_game_resources->window_manager().poll_event(event)) {
         switch (event.type) {
             case sf::Event::Closed: {
+                wait_for_render_thread();
                 _scenes.clear();
                 break;
             }
@@ -116,6 +245,17 @@ void Engine::process_window_events() {
                 break;
             }
             case sf::Event::KeyPressed: {
+                if (event.key.scancode == frame_statistics_key &&
+                    _frame_statistics_scene) {
+                    _show_frame_statistics = !_show_frame_statistics;
+                    break;
+                }
+#ifdef PROFILING
+                if (event.key.scancode == profile_key) {
+                    write_profile();
+                    break;
+                }
+#endif
                 notify(
                     KeyboardEvent(KeyboardEvent::KeyboardEventType::KeyPressed,
                                   event.key.scancode));
@@ -181,10 +321,16 @@ void Engine::pop_scene() {
 void Engine::process_scene_events() {
     if (_scene_events.size() == 0) {
         return;
-    } else if (_scene_events.size() > 1) {
+    }
+    // Scenes may be destroyed, which the current frame could be using, and
+    // created, which could use the fonts it is drawn with
+    wait_for_render_thread();
+    if (_scene_events.size() > 1) {
         throw std::runtime_error("More than one SceneEvent has happened.");
     }
     auto& next_scene = _scene_events[0].target_scene;
+    if (!next_scene && _scene_events[0].scene_factory)
+        next_scene = _scene_events[0].scene_factory();
     switch (_scene_events[0].scene_event_type) {
         case SceneEvent::SceneEventType::Clear: {
             _scenes.clear();
@@ -240,22 +386,59 @@ void Engine::on_notify(const GameEvent& event) {
     }
 }
 
-void Engine::draw() {
-    auto& window_manager = _game_resources->window_manager();
-    window_manager.clear(sf::Color::Black);
+std::vector<Scene*> Engine::visible_scenes() const {
     auto sceneIter = _scenes.rbegin();
     // Find top-most scene that is solid
     while (std::next(sceneIter) != _scenes.rend() &&
            (*sceneIter)->draw_state() != Scene::DrawState::Solid) {
         ++sceneIter;
     }
+    std::vector<Scene*> scenes;
     while (sceneIter != _scenes.rbegin()) {
         if ((*sceneIter)->draw_state() != Scene::DrawState::Skip) {
-            window_manager.draw(*(sceneIter)->get());
+            scenes.push_back(sceneIter->get());
         }
         sceneIter--;
     }
-    window_manager.draw(*_scenes.back());
+    scenes.push_back(_scenes.back().get());
+    return scenes;
+}
+
+void Engine::draw() {
+    PROFILE_ZONE("Draw");
+    auto& window_manager = _game_resources->window_manager();
+    window_manager.clear(sf::Color::Black);
+    for (auto scene : visible_scenes())
+        window_manager.draw(*scene);
+    if (_show_frame_statistics)
+        window_manager.draw(*_frame_statistics_scene);
     window_manager.display();
 }
+
+void Engine::draw_pipelined() {
+    PROFILE_ZONE("Record frame");
+    auto scenes = visible_scenes();
+    auto& snapshot = _render_thread->back_snapshot();
+    snapshot.clear();
+    auto default_view = _game_resources->window_manager().default_view();
+    for (auto scene : scenes) {
+        snapshot.set_view(default_view);
+        if (!scene->take_snapshot(snapshot)) {
+            // Menus and the like are cheap to draw, so they are drawn while
+            // this thread waits
+            _render_thread->run([this] { draw(); });
+            return;
+        }
+    }
+    if (_show_frame_statistics) {
+        snapshot.set_view(default_view);
+        _frame_statistics_scene->take_snapshot(snapshot);
+    }
+    _render_thread->publish();
+}
+
+void Engine::wait_for_render_thread() {
+    if (_render_thread)
+        _render_thread->wait_until_idle();
+}
 }  // namespace VVipers
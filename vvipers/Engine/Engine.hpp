@@ -3,13 +3,18 @@
 #include <deque>
 #include <memory>
 #include <vvipers/Engine/GameResources.hpp>
+#include <vvipers/Engine/RenderThread.hpp>
 #include <vvipers/Engine/Scene.hpp>
+#include <vvipers/Scenes/FrameStatisticsScene.hpp>
+#include <vvipers/Utilities/FrameStatistics.hpp>
 
 #include "vvipers/GameElements/GameEvent.hpp"
 #include "vvipers/GameElements/Observer.hpp"
 
 namespace VVipers {
 
+class FramePacer;
+
 class Engine : public Observable, public Observer {
   public:
     Engine(std::unique_ptr<GameResources>);
@@ -23,17 +28,40 @@ class Engine : public Observable, public Observer {
 
   private:
     void draw();
+    /** Records the frame for the render thread if all visible scenes can be
+     * recorded, otherwise they are drawn on the render thread directly **/
+    void draw_pipelined();
     void game_loop(double fps);
+    void log_frame_statistics() const;
+    /** Writes the profiling zones recorded since the last time as a Chrome
+     * trace, numbered so that earlier traces are kept **/
+    void write_profile() const;
+    void log_pacing_statistics(FramePacer& pacer);
     void pop_scene();
     void process_window_events();
     void process_scene_events();
     void update(Time elapsedTime);
+    /** Runs as many fixed steps as the elapsed time allows, within limits.
+     * @returns how far into the next step the time left over reaches **/
+    double update_in_fixed_steps(Time elapsedTime);
+    void interpolate_scenes(double interpolation);
+    std::vector<Scene*> visible_scenes() const;
+    void wait_for_render_thread();
 
     // Scenes are owned by either this stack or other Scenes.
     std::deque<std::shared_ptr<Scene>> _scenes;
     std::unique_ptr<GameResources> _game_resources;
     std::shared_ptr<Scene> _defaultScene;
     std::vector<SceneEvent> _scene_events;
+    Time _update_step;  // Zero if every frame is one update
+    Time _accumulated_time;
+    bool _vertical_sync;
+    FrameStatistics _frame_statistics;
+    // Drawn on top of the scenes when shown, not part of the scene stack
+    std::unique_ptr<FrameStatisticsScene> _frame_statistics_scene;
+    bool _show_frame_statistics;
+    // Declared last so that it stops before the scenes are destroyed
+    std::unique_ptr<RenderThread> _render_thread;
 };
 
 }  // namespace VVipers
\ No newline at end of file
@@ -4,10 +4,13 @@
 
 namespace VVipers {
 
-FontFileLoader::FontFileLoader(const OptionsProvider& options)
+FontFileLoader::FontFileLoader(const OptionsProvider& options,
+                               bool with_graphics)
     : _default_font(nullptr) {
     _resource_directory_path =
         options.option_string("General/resourceDirectoryPath");
+    if (!with_graphics)
+        return;
     for (auto& fontname : options.option_string_array("General/fonts"))
         load_font(fontname);
     auto defaultFont = options.option_string("General/defaultFont");
@@ -10,7 +10,9 @@ class GameOptions;
 
 class FontFileLoader : public FontProvider {
   public:
-    FontFileLoader(const OptionsProvider& options);
+    /** Without graphics no fonts are loaded and every font is null, since
+     * glyphs are rasterised into textures that need a graphics context. **/
+    FontFileLoader(const OptionsProvider& options, bool with_graphics = true);
     ~FontFileLoader();
     const sf::Font* default_font() const override;
     /** @returns default font if the wanted font is not found **/
@@ -6,16 +6,35 @@
 #include <vvipers/Engine/ColorPalette.hpp>
 #include <vvipers/Engine/Engine.hpp>
 #include <vvipers/Engine/FontFileLoader.hpp>
+#include <vvipers/Engine/HeadlessWindowManager.hpp>
+#include <vvipers/Engine/RenderWindowManager.hpp>
 #include <vvipers/Engine/TextureFileLoader.hpp>
 
 namespace VVipers {
 
 GameResources::GameResources(std::unique_ptr<OptionsProvider> options)
     : _options_provider(std::move(options)),
-      _font_provider(*_options_provider),
-      _texture_provider(*_options_provider),
+      _is_headless(_options_provider->is_option_set("General/headless") &&
+                   _options_provider->option_boolean("General/headless")),
+      _font_provider(*_options_provider, !_is_headless),
+      _texture_provider(*_options_provider, !_is_headless),
+      _color_provider(*_options_provider) {
+    sf::Vector2u window_size(
+        _options_provider->option_2d_vector("General/windowSize"));
+    if (_is_headless)
+        _window_manager = std::make_unique<HeadlessWindowManager>(window_size);
+    else
+        _window_manager = std::make_unique<RenderWindowManager>(window_size);
+}
+
+GameResources::GameResources(std::unique_ptr<OptionsProvider> options,
+                             std::unique_ptr<WindowManager> window_manager)
+    : _options_provider(std::move(options)),
+      _is_headless(_options_provider->is_option_set("General/headless") &&
+                   _options_provider->option_boolean("General/headless")),
+      _font_provider(*_options_provider, !_is_headless),
+      _texture_provider(*_options_provider, !_is_headless),
       _color_provider(*_options_provider),
-      _window_manager(sf::Vector2u(
-          _options_provider->option_2d_vector("General/windowSize"))) {}
+      _window_manager(std::move(window_manager)) {}
 
 }  // namespace VVipers
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <memory>
 #include <vvipers/Engine/Providers.hpp>
 #include <vvipers/Engine/Scene.hpp>
+#include "vvipers/Engine/HeadlessWindowManager.hpp"
 #include "vvipers/Engine/WindowManager.hpp"
 #include "vvipers/Engine/ColorPalette.hpp"
 #include "vvipers/Engine/FontFileLoader.hpp"
@@ -14,21 +15,30 @@ namespace VVipers {
 
 class GameResources {
   public:
+    /** No window is opened if the option General/headless is set. Headless
+     * resources need no graphics context: fonts and textures are null. **/
     GameResources(std::unique_ptr<OptionsProvider> options);
+    /** Uses the given window manager, e.g. a HeadlessWindowManager driving
+     * the game with its input script in tests and benchmarks. Headless if
+     * the option General/headless is set. **/
+    GameResources(std::unique_ptr<OptionsProvider> options,
+                  std::unique_ptr<WindowManager> window_manager);
+    bool is_headless() const { return _is_headless; }
     const ColorProvider& color_service() const { return _color_provider; }
     const FontProvider& font_service() const { return _font_provider; }
     OptionsProvider& options_service() const { return *_options_provider; }
     const TextureProvider& texture_service() const {
         return _texture_provider;
     }
-    WindowManager& window_manager() {return _window_manager;}
+    WindowManager& window_manager() { return *_window_manager; }
 
   private:
     const std::unique_ptr<OptionsProvider> _options_provider;
+    const bool _is_headless;
     const FontFileLoader _font_provider;
     const TextureFileLoader _texture_provider;
     const ColorPalette _color_provider;
-    WindowManager _window_manager;
+    std::unique_ptr<WindowManager> _window_manager;
 };
 
 }  // namespace VVipers
@@ -0,0 +1,153 @@
+#include <vvipers/Engine/HeadlessWindowManager.hpp>
+
+namespace VVipers {
+
+HeadlessWindowManager::HeadlessWindowManager(const sf::Vector2u& window_size)
+    : _window_size(window_size),
+      _is_mouse_grabbed(false),
+      _frame(0),
+      _new_frame(true) {
+    center_mouse();
+}
+
+void HeadlessWindowManager::center_mouse() {
+    std::lock_guard lock(_mutex);
+    _mouse_position = sf::Vector2i(_window_size.x / 2, _window_size.y / 2);
+}
+
+sf::View HeadlessWindowManager::default_view() const {
+    auto size = window_size();
+    return sf::View(sf::FloatRect(0, 0, size.x, size.y));
+}
+
+size_t HeadlessWindowManager::frame() const {
+    std::lock_guard lock(_mutex);
+    return _frame;
+}
+
+bool HeadlessWindowManager::is_mouse_grabbed() const {
+    std::lock_guard lock(_mutex);
+    return _is_mouse_grabbed;
+}
+
+bool HeadlessWindowManager::is_key_pressed(sf::Keyboard::Scancode key) const {
+    std::lock_guard lock(_mutex);
+    return _pressed_keys.contains(key);
+}
+
+bool HeadlessWindowManager::is_mouse_button_pressed(
+    sf::Mouse::Button button) const {
+    std::lock_guard lock(_mutex);
+    return _pressed_buttons.contains(button);
+}
+
+// Same as sf::RenderTarget for views that are not rotated
+sf::Vector2i HeadlessWindowManager::map_coordinates_to_pixel_values(
+    const Vec2& coordinates, const sf::View& view) const {
+    auto window = window_size();
+    Vec2 size = view.getSize();
+    Vec2 corner = Vec2(view.getCenter()) - 0.5 * size;
+    const auto& viewport = view.getViewport();
+    return sf::Vector2i(
+        (viewport.left + viewport.width * (coordinates.x - corner.x) / size.x) *
+                window.x +
+            0.5,
+        (viewport.top + viewport.height * (coordinates.y - corner.y) / size.y) *
+                window.y +
+            0.5);
+}
+
+Vec2 HeadlessWindowManager::map_pixel_values_to_coordinates(
+    const sf::Vector2i& pixel_values, const sf::View& view) const {
+    auto window = window_size();
+    Vec2 size = view.getSize();
+    Vec2 corner = Vec2(view.getCenter()) - 0.5 * size;
+    const auto& viewport = view.getViewport();
+    return corner +
+           Vec2((double(pixel_values.x) / window.x - viewport.left) /
+                    viewport.width * size.x,
+                (double(pixel_values.y) / window.y - viewport.top) /
+                    viewport.height * size.y);
+}
+
+sf::Vector2i HeadlessWindowManager::mouse_position() const {
+    std::lock_guard lock(_mutex);
+    return _mouse_position;
+}
+
+bool HeadlessWindowManager::poll_event(sf::Event& event) {
+    // The engine polls until there are no events once per frame
+    bool new_frame;
+    size_t frame;
+    {
+        std::lock_guard lock(_mutex);
+        new_frame = _new_frame;
+        frame = _frame;
+        _new_frame = false;
+    }
+    if (new_frame) {
+        // Not under _mutex, since the script pushes events
+        std::lock_guard script_lock(_script_mutex);
+        if (_script)
+            _script(frame, *this);
+    }
+    std::lock_guard lock(_mutex);
+    if (_events.empty()) {
+        _new_frame = true;
+        ++_frame;
+        return false;
+    }
+    event = _events.front();
+    _events.pop_front();
+    apply(event);
+    return true;
+}
+
+void HeadlessWindowManager::set_grab_mouse(bool grabbed) {
+    std::lock_guard lock(_mutex);
+    _is_mouse_grabbed = grabbed;
+}
+
+void HeadlessWindowManager::set_input_script(InputScript script) {
+    std::lock_guard lock(_script_mutex);
+    _script = std::move(script);
+}
+
+sf::Vector2u HeadlessWindowManager::window_size() const {
+    std::lock_guard lock(_mutex);
+    return _window_size;
+}
+
+void HeadlessWindowManager::push_event(const sf::Event& event) {
+    std::lock_guard lock(_mutex);
+    _events.push_back(event);
+}
+
+void HeadlessWindowManager::apply(const sf::Event& event) {
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+            _pressed_keys.insert(event.key.scancode);
+            break;
+        case sf::Event::KeyReleased:
+            _pressed_keys.erase(event.key.scancode);
+            break;
+        case sf::Event::MouseButtonPressed:
+            _pressed_buttons.insert(event.mouseButton.button);
+            _mouse_position = {event.mouseButton.x, event.mouseButton.y};
+            break;
+        case sf::Event::MouseButtonReleased:
+            _pressed_buttons.erase(event.mouseButton.button);
+            _mouse_position = {event.mouseButton.x, event.mouseButton.y};
+            break;
+        case sf::Event::MouseMoved:
+            _mouse_position = {event.mouseMove.x, event.mouseMove.y};
+            break;
+        case sf::Event::Resized:
+            _window_size = {event.size.width, event.size.height};
+            break;
+        default:
+            break;
+    }
+}
+
+}  // namespace VVipers
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <vvipers/Engine/WindowManager.hpp>
+
+namespace VVipers {
+
+/** Stands in for the window when there is nothing to show, e.g. for
+ * benchmarks and automated play. Nothing is drawn, and the input comes from
+ * events that are queued or written by a script once per frame. **/
+class HeadlessWindowManager : public WindowManager {
+  public:
+    /** Called with the number of the frame when the events of a new frame are
+     * polled. It runs on the thread polling the events. **/
+    using InputScript =
+        std::function<void(size_t frame, HeadlessWindowManager&)>;
+
+    HeadlessWindowManager(const sf::Vector2u& window_size);
+    void center_mouse() override;
+    void clear(const sf::Color&) override {}
+    sf::View default_view() const override;
+    void display() override {}
+    void draw(const sf::Drawable&) override {}
+    bool is_key_pressed(sf::Keyboard::Scancode key) const override;
+    bool is_mouse_button_pressed(sf::Mouse::Button button) const override;
+    bool is_mouse_grabbed() const override;
+    sf::Vector2i map_coordinates_to_pixel_values(
+        const Vec2& coordinates, const sf::View& view) const override;
+    Vec2 map_pixel_values_to_coordinates(const sf::Vector2i& pixel_values,
+                                         const sf::View& view) const override;
+    sf::Vector2i mouse_position() const override;
+    /** Key, button and mouse states follow the events as they are polled **/
+    bool poll_event(sf::Event& event) override;
+    bool set_active(bool) override { return true; }
+    void set_grab_mouse(bool grabbed) override;
+    void set_vertical_sync(bool) override {}
+    sf::Vector2u window_size() const override;
+
+    void push_event(const sf::Event& event);
+    void set_input_script(InputScript script);
+    size_t frame() const;
+
+  private:
+    void apply(const sf::Event& event);
+
+    sf::Vector2u _window_size;
+    bool _is_mouse_grabbed;
+    sf::Vector2i _mouse_position;
+    std::set<sf::Keyboard::Scancode> _pressed_keys;
+    std::set<sf::Mouse::Button> _pressed_buttons;
+    // Guards everything but the script, since events may be pushed and the
+    // state read from other threads
+    mutable std::mutex _mutex;
+    std::deque<sf::Event> _events;
+    std::mutex _script_mutex;  // Held while the script runs
+    InputScript _script;
+    size_t _frame;
+    bool _new_frame;
+};
+
+}  // namespace VVipers
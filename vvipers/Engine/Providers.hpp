@@ -1,6 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <string>
 #include <vector>
 #include <vvipers/Utilities/Vec2.hpp>
@@ -21,6 +22,7 @@ class ColorProvider {
 class FontProvider {
   public:
     virtual ~FontProvider() {}
+    /** Null when running headless, texts are then left without a font **/
     virtual const sf::Font* default_font() const = 0;
     /** @returns default font if the wanted font is not found **/
     virtual const sf::Font* font(const std::string& fontname) const = 0;
@@ -77,8 +79,12 @@ class OptionsProvider {
 class TextureProvider {
   public:
     virtual ~TextureProvider() {}
+    /** Null when running headless **/
     virtual const sf::Texture* texture(
         const std::string& texturename) const = 0;
+    /** @returns the part of the texture that belongs to texturename, several
+     * textures may share the same atlas **/
+    virtual sf::IntRect texture_rect(const std::string& texturename) const = 0;
 };
 
 }  // namespace VVipers
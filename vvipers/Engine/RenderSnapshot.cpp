@@ -0,0 +1,82 @@
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <vvipers/Engine/RenderSnapshot.hpp>
+
+namespace VVipers {
+
+void RenderSnapshot::clear() {
+    // Keeps the storage, the snapshots are refilled every frame
+    _commands.clear();
+    _vertices.clear();
+}
+
+void RenderSnapshot::set_view(const sf::View& view) {
+    Command command{Command::Kind::View};
+    command.view = view;
+    _commands.push_back(std::move(command));
+}
+
+void RenderSnapshot::add_vertices(const sf::Vertex* vertices, size_t count,
+                                  sf::PrimitiveType type,
+                                  const sf::RenderStates& states) {
+    if (count == 0)
+        return;
+    Command command{Command::Kind::Vertices};
+    command.type = type;
+    command.first = _vertices.size();
+    command.count = count;
+    command.states = states;
+    _vertices.insert(_vertices.end(), vertices, vertices + count);
+    _commands.push_back(std::move(command));
+}
+
+void RenderSnapshot::add_reference(const sf::Drawable& drawable,
+                                   const sf::RenderStates& states) {
+    add_drawable(nullptr, &drawable, states);
+}
+
+void RenderSnapshot::add_drawable(std::shared_ptr<const sf::Drawable> copy,
+                                  const sf::Drawable* reference,
+                                  const sf::RenderStates& states) {
+    Command command{Command::Kind::Drawable};
+    command.drawable = copy ? copy.get() : reference;
+    command.copy = std::move(copy);
+    command.states = states;
+    _commands.push_back(std::move(command));
+}
+
+void RenderSnapshot::draw(sf::RenderTarget& target,
+                          sf::RenderStates states) const {
+    bool use_buffer = sf::VertexBuffer::isAvailable() && !_vertices.empty();
+    if (use_buffer) {
+        if (_buffer.getVertexCount() < _vertices.size())
+            _buffer.create(2 * _vertices.size());
+        _buffer.update(_vertices.data(), _vertices.size(), 0);
+    }
+    for (const auto& command : _commands) {
+        sf::RenderStates command_states = command.states;
+        command_states.transform = states.transform * command.states.transform;
+        switch (command.kind) {
+            case Command::Kind::View: {
+                target.setView(command.view);
+                break;
+            }
+            case Command::Kind::Vertices: {
+                if (use_buffer) {
+                    _buffer.setPrimitiveType(command.type);
+                    target.draw(_buffer, command.first, command.count,
+                                command_states);
+                } else {
+                    target.draw(_vertices.data() + command.first,
+                                command.count, command.type, command_states);
+                }
+                break;
+            }
+            case Command::Kind::Drawable: {
+                target.draw(*command.drawable, command_states);
+                break;
+            }
+        }
+    }
+}
+
+}  // namespace VVipers
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <memory>
+#include <vector>
+
+namespace VVipers {
+
+/** A recorded frame that can be drawn on another thread while the scenes that
+ * recorded it are updated. Vertices are copied into the snapshot, drawables
+ * are either copied or referenced if they do not change once created. **/
+class RenderSnapshot : public sf::Drawable {
+  public:
+    void clear();
+    bool empty() const { return _commands.empty(); }
+    /** The view of everything added after this call **/
+    void set_view(const sf::View& view);
+    void add_vertices(const sf::Vertex* vertices, size_t count,
+                      sf::PrimitiveType type,
+                      const sf::RenderStates& states = sf::RenderStates());
+    template <class T>
+    void add_copy(const T& drawable,
+                  const sf::RenderStates& states = sf::RenderStates()) {
+        add_drawable(std::make_shared<T>(drawable), nullptr, states);
+    }
+    /** The drawable must stay unchanged for as long as the snapshot is used **/
+    void add_reference(const sf::Drawable& drawable,
+                       const sf::RenderStates& states = sf::RenderStates());
+    size_t vertex_count() const { return _vertices.size(); }
+    /** All vertices are streamed to one vertex buffer per draw if vertex
+     * buffers are available, otherwise they are drawn from memory. **/
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+  private:
+    struct Command {
+        enum class Kind { View, Vertices, Drawable } kind;
+        sf::View view;
+        sf::PrimitiveType type = sf::PrimitiveType::Points;
+        size_t first = 0;
+        size_t count = 0;
+        sf::RenderStates states;
+        std::shared_ptr<const sf::Drawable> copy;
+        const sf::Drawable* drawable = nullptr;
+    };
+    void add_drawable(std::shared_ptr<const sf::Drawable> copy,
+                      const sf::Drawable* reference,
+                      const sf::RenderStates& states);
+
+    std::vector<Command> _commands;
+    std::vector<sf::Vertex> _vertices;
+    // Only touched by the thread that draws, only grows
+    mutable sf::VertexBuffer _buffer{sf::PrimitiveType::Points,
+                                     sf::VertexBuffer::Stream};
+};
+
+}  // namespace VVipers
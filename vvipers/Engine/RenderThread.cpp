@@ -0,0 +1,103 @@
+#include <utility>
+#include <vvipers/Engine/RenderThread.hpp>
+#include <vvipers/Engine/WindowManager.hpp>
+#include <vvipers/Utilities/Profiler.hpp>
+
+namespace VVipers {
+
+RenderThread::RenderThread(WindowManager& window_manager)
+    : _window_manager(window_manager),
+      _back(0),
+      _snapshot(nullptr),
+      _task(nullptr),
+      _busy(false),
+      _stopping(false) {
+    // The context can only be active in one thread at a time
+    _window_manager.set_active(false);
+    _thread = std::thread(&RenderThread::work, this);
+}
+
+RenderThread::~RenderThread() {
+    {
+        std::unique_lock lock(_mutex);
+        _job_done.wait(lock, [this] { return !_busy; });
+        _stopping = true;
+    }
+    _job_available.notify_all();
+    _thread.join();
+    _window_manager.set_active(true);
+}
+
+void RenderThread::publish() {
+    std::unique_lock lock(_mutex);
+    _snapshot = &_snapshots[_back];
+    start_job(lock);
+    // The front snapshot is not touched again until the next publish
+    _back = 1 - _back;
+}
+
+void RenderThread::run(const std::function<void()>& task) {
+    std::unique_lock lock(_mutex);
+    _task = &task;
+    start_job(lock);
+    _job_done.wait(lock, [this] { return !_busy; });
+    if (_exception)
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+}
+
+void RenderThread::wait_until_idle() {
+    std::unique_lock lock(_mutex);
+    _job_done.wait(lock, [this] { return !_busy; });
+    if (_exception)
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+}
+
+// Expects the job to be set, waits for the previous one to finish
+void RenderThread::start_job(std::unique_lock<std::mutex>& lock) {
+    auto snapshot = std::exchange(_snapshot, nullptr);
+    auto task = std::exchange(_task, nullptr);
+    _job_done.wait(lock, [this] { return !_busy; });
+    if (_exception)
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    _snapshot = snapshot;
+    _task = task;
+    _busy = true;
+    _job_available.notify_all();
+}
+
+void RenderThread::work() {
+    _window_manager.set_active(true);
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _job_available.wait(lock, [this] { return _stopping || _busy; });
+        if (_stopping)
+            break;
+        auto snapshot = _snapshot;
+        auto task = _task;
+        lock.unlock();
+        std::exception_ptr exception;
+        try {
+            PROFILE_ZONE("Render");
+            if (snapshot) {
+                _window_manager.clear(sf::Color::Black);
+                _window_manager.draw(*snapshot);
+                _window_manager.display();
+            } else if (task) {
+                (*task)();
+            }
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        lock.lock();
+        if (exception && !_exception)
+            _exception = exception;
+        _snapshot = nullptr;
+        _task = nullptr;
+        _busy = false;
+        _job_done.notify_all();
+    }
+    lock.unlock();
+    _window_manager.set_active(false);
+}
+
+}  // namespace VVipers
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vvipers/Engine/RenderSnapshot.hpp>
+
+namespace VVipers {
+
+class WindowManager;
+
+/** Owns the window while it is running and draws the snapshots published by
+ * the simulation thread. Two snapshots are used: the simulation fills one
+ * while the other one is drawn, so that updating the next frame overlaps with
+ * drawing the current one. **/
+class RenderThread {
+  public:
+    RenderThread(WindowManager& window_manager);
+    ~RenderThread();
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+    /** The snapshot to record the next frame into **/
+    RenderSnapshot& back_snapshot() { return _snapshots[_back]; }
+    /** Hands the back snapshot over to be drawn and displayed. Waits for the
+     * previous frame to be finished first. **/
+    void publish();
+    /** Runs task on the render thread, for drawing that cannot be recorded,
+     * and waits for it to finish **/
+    void run(const std::function<void()>& task);
+    /** Waits for the current frame, e.g. before anything it uses is
+     * destroyed. An exception thrown while drawing is rethrown here. **/
+    void wait_until_idle();
+
+  private:
+    void start_job(std::unique_lock<std::mutex>& lock);
+    void work();
+
+    WindowManager& _window_manager;
+    std::array<RenderSnapshot, 2> _snapshots;
+    size_t _back;
+    std::mutex _mutex;
+    std::condition_variable _job_available;
+    std::condition_variable _job_done;
+    const RenderSnapshot* _snapshot;       // Drawn by the current job
+    const std::function<void()>* _task;  // Or run by it
+    bool _busy;
+    bool _stopping;
+    std::exception_ptr _exception;
+    std::thread _thread;
+};
+
+}  // namespace VVipers
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <vvipers/Engine/WindowManager.hpp>
+
+namespace VVipers {
+
+/** Opens a window on the screen **/
+class RenderWindowManager : public WindowManager {
+  public:
+    RenderWindowManager(const sf::Vector2u& window_size);
+    void center_mouse() override;
+    void clear(const sf::Color& color) override { _window.clear(color); }
+    sf::View default_view() const override {
+        return _window.getDefaultView();
+    }
+    void display() override { _window.display(); }
+    void draw(const sf::Drawable& drawable) override { _window.draw(drawable); }
+    bool is_key_pressed(sf::Keyboard::Scancode key) const override {
+        return sf::Keyboard::isKeyPressed(key);
+    }
+    bool is_mouse_button_pressed(sf::Mouse::Button button) const override {
+        return sf::Mouse::isButtonPressed(button);
+    }
+    bool is_mouse_grabbed() const override { return _is_mouse_grabbed; }
+    sf::Vector2i map_coordinates_to_pixel_values(
+        const Vec2& coordinates, const sf::View& view) const override {
+        return _window.mapCoordsToPixel(sf::Vector2f(coordinates), view);
+    }
+    Vec2 map_pixel_values_to_coordinates(const sf::Vector2i& pixel_values,
+                                         const sf::View& view) const override {
+        return _window.mapPixelToCoords(pixel_values, view);
+    }
+    sf::Vector2i mouse_position() const override;
+    bool poll_event(sf::Event& event) override {
+        return _window.pollEvent(event);
+    }
+    bool set_active(bool active) override { return _window.setActive(active); }
+    void set_grab_mouse(bool grabbed) override;
+    void set_vertical_sync(bool enabled) override {
+        _window.setVerticalSyncEnabled(enabled);
+    }
+    sf::Vector2u window_size() const override { return _window.getSize(); }
+
+  private:
+    bool _is_mouse_grabbed;
+    sf::RenderWindow _window;
+};
+
+}  // namespace VVipers
@@ -10,6 +10,7 @@ namespace VVipers {
 
 class Scene;
 class GameResources;
+class RenderSnapshot;
 
 class Scene : public sf::Drawable, public Observable, public Observer {
   public:
@@ -18,11 +19,17 @@ class Scene : public sf::Drawable, public Observable, public Observer {
 
     Scene(GameResources& game);
     DrawState draw_state() const { return _draw_state; }
-    GameResources& game_resources() { return _game; }
+    GameResources& game_resources() const { return _game; }
+    /** Called before drawing, to draw a state between the last two updates
+     * where 0 is the previous and 1 the latest. **/
+    virtual void interpolate(double interpolation) {}
     virtual void on_activation();
     RunState run_state() const { return _run_state; }
     void set_draw_state(DrawState state) { _draw_state = state; }
     void set_run_state(RunState state) { _run_state = state; }
+    /** Records what draw would draw, so that it can be drawn on another
+     * thread. Returns false if the scene cannot be recorded. **/
+    virtual bool take_snapshot(RenderSnapshot& snapshot) const { return false; }
     virtual void update(const Time& elapsed_time) = 0;
 
   private:
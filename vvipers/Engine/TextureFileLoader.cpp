@@ -1,15 +1,18 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
 #include <sstream>
 #include <vvipers/Engine/TextureFileLoader.hpp>
 #include <vvipers/Utilities/debug.hpp>
 
 namespace VVipers {
 
-TextureFileLoader::TextureFileLoader(const OptionsProvider& options) {
+TextureFileLoader::TextureFileLoader(const OptionsProvider& options,
+                                     bool with_graphics) {
     auto resourceDirectoryPath =
         options.option_string("General/resourceDirectoryPath");
 
+    std::vector<TexturePart> parts;
     std::stringstream ss;
     for (auto viperPart : {"ViperHead", "ViperBody", "ViperTail"}) {
         ss.str("");
@@ -24,21 +27,73 @@ TextureFileLoader::TextureFileLoader(const OptionsProvider& options) {
         ss << "ViperModel/" << viperPart << "/repeated";
         auto repeated = options.option_boolean(ss.str());
 
-        ss.str("");
-        ss << resourceDirectoryPath << filename;
-        sf::Texture* texture = new sf::Texture;
         sf::IntRect area(cropRect[0], cropRect[1], cropRect[2], cropRect[3]);
-        texture->loadFromFile(ss.str(), area);
-        texture->setRepeated(repeated);
+        parts.push_back(
+            {viperPart, resourceDirectoryPath + filename, area, repeated});
+    }
+    build_atlas(parts, with_graphics);
+    _images.clear();
+}
 
-        _textures[viperPart] = texture;
+const sf::Image& TextureFileLoader::decoded_image(const std::string& filename) {
+    if (!_images.contains(filename)) {
+        if (!_images[filename].loadFromFile(filename))
+            log_error("Could not load texture file ", filename);
     }
+    return _images.at(filename);
 }
 
-TextureFileLoader::~TextureFileLoader() {
-    for( auto texture : _textures){
-        delete texture.second;
+/* The parts are placed next to each other, each in a column as tall as the
+ * atlas. The atlas is repeated, so a repeated part that is as tall as the atlas
+ * wraps vertically onto itself. Repeated parts of any other height cannot wrap
+ * within the atlas and get a texture of their own. */
+void TextureFileLoader::build_atlas(const std::vector<TexturePart>& parts,
+                                    bool with_graphics) {
+    const int padding = 2;  // Keeps filtering from bleeding between parts
+    int atlas_height = 0;
+    for (const auto& part : parts)
+        atlas_height = std::max(atlas_height, part.crop.height);
+
+    int atlas_width = 0;
+    std::vector<const TexturePart*> atlas_parts;
+    for (const auto& part : parts) {
+        if (part.repeated && part.crop.height != atlas_height) {
+            _texture_rects[part.name] =
+                sf::IntRect(0, 0, part.crop.width, part.crop.height);
+            if (!with_graphics)
+                continue;
+            auto texture = std::make_unique<sf::Texture>();
+            texture->loadFromImage(decoded_image(part.filename), part.crop);
+            texture->setRepeated(true);
+            _textures[part.name] = texture.get();
+            _owned_textures.push_back(std::move(texture));
+            continue;
+        }
+        if (!atlas_parts.empty())
+            atlas_width += padding;
+        _texture_rects[part.name] =
+            sf::IntRect(atlas_width, 0, part.crop.width, part.crop.height);
+        atlas_width += part.crop.width;
+        atlas_parts.push_back(&part);
     }
+    if (atlas_parts.empty() || !with_graphics)
+        return;
+
+    sf::Image atlas_image;
+    atlas_image.create(atlas_width, atlas_height, sf::Color::Transparent);
+    for (auto part : atlas_parts) {
+        const auto& image = decoded_image(part->filename);
+        if (image.getSize().x == 0)  // Could not be loaded
+            continue;
+        atlas_image.copy(image, _texture_rects[part->name].left, 0, part->crop);
+    }
+    auto atlas = std::make_unique<sf::Texture>();
+    atlas->loadFromImage(atlas_image);
+    atlas->setRepeated(std::ranges::any_of(
+        atlas_parts, [](auto part) { return part->repeated; }));
+    for (auto part : atlas_parts)
+        _textures[part->name] = atlas.get();
+    _owned_textures.push_back(std::move(atlas));
 }
 
 const sf::Texture* TextureFileLoader::texture(
@@ -48,10 +103,11 @@ const sf::Texture* TextureFileLoader::texture(
     return nullptr;
 }
 
-const sf::Texture* TextureFileLoader::load_texture(const std::string& filename,
-                                                  sf::FloatRect,
-                                                  bool repeatable) {
-    return nullptr;
+sf::IntRect TextureFileLoader::texture_rect(
+    const std::string& texturename) const {
+    if (_texture_rects.contains(texturename))
+        return _texture_rects.at(texturename);
+    return sf::IntRect();
 }
 
 }  // namespace VVipers
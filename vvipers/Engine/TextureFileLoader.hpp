@@ -1,22 +1,42 @@
 #pragma once
 
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
 #include <map>
+#include <memory>
+#include <vector>
 #include <vvipers/Engine/Providers.hpp>
 
 namespace VVipers {
 
 class GameOptions;
 
+/** Loads the viper textures into a single atlas, so that all parts can be drawn
+ * without switching textures. Every image file is only decoded once. **/
 class TextureFileLoader : public TextureProvider {
   public:
-    TextureFileLoader(const OptionsProvider& options);
-    ~TextureFileLoader();
+    /** Without graphics only the texture rects are laid out, and every texture
+     * is null, so that no graphics context is needed. **/
+    TextureFileLoader(const OptionsProvider& options,
+                      bool with_graphics = true);
     const sf::Texture* texture(const std::string& texturename) const override;
+    sf::IntRect texture_rect(const std::string& texturename) const override;
 
   private:
-    const sf::Texture* load_texture(const std::string& filename, sf::FloatRect,
-                                    bool repeatable);
+    struct TexturePart {
+        std::string name;
+        std::string filename;
+        sf::IntRect crop;
+        bool repeated;
+    };
+    const sf::Image& decoded_image(const std::string& filename);
+    void build_atlas(const std::vector<TexturePart>& parts,
+                     bool with_graphics);
+    std::map<std::string, sf::Image> _images;  // Only while loading
+    std::vector<std::unique_ptr<sf::Texture>> _owned_textures;
     std::map<const std::string, const sf::Texture*> _textures;
+    std::map<const std::string, sf::IntRect> _texture_rects;
 };
 
 }  // namespace VVipers
@@ -6,12 +6,13 @@
 namespace VVipers {
 
 void KeyboardController::update(const Time&) {
+    const auto& window_manager = _game_resources.window_manager();
     SteeringCommand cmd;
     // Only send event if something has changed since last time
     bool key_pressed;
 
     static bool last_left = false;
-    key_pressed = sf::Keyboard::isKeyPressed(_keys.left);
+    key_pressed = window_manager.is_key_pressed(_keys.left);
     if (key_pressed) {
         // This is not the actual turn, but how much the viper wants to turn
         cmd.turn -= 1.;
@@ -23,7 +24,7 @@ void KeyboardController::update(const Time&) {
     last_left = key_pressed;
 
     static bool last_right = false;
-    key_pressed = sf::Keyboard::isKeyPressed(_keys.right);
+    key_pressed = window_manager.is_key_pressed(_keys.right);
     if (key_pressed) {
         // This is not the actual turn, but how much the viper wants to turn
         cmd.turn += 1.;
@@ -35,7 +36,7 @@ void KeyboardController::update(const Time&) {
     last_right = key_pressed;
 
     static bool last_boost = false;
-    key_pressed = sf::Keyboard::isKeyPressed(_keys.boost);
+    key_pressed = window_manager.is_key_pressed(_keys.boost);
     if (key_pressed) {
         cmd.boost = true;
         if (!last_boost)
@@ -62,7 +63,8 @@ void MouseController::update(const Time&) {
     SteeringCommand command;
     command.turn = (_game_resources.window_manager().mouse_position().x -
                     window_half_width) / full_turn_in_pixels;
-    command.boost = sf::Mouse::isButtonPressed(sf::Mouse::Left);
+    command.boost = _game_resources.window_manager().is_mouse_button_pressed(
+        sf::Mouse::Left);
     // This might cause problems if anything else uses the mouse
     _game_resources.window_manager().center_mouse();
     command.enable = true;
@@ -38,10 +38,13 @@ class KeyboardController : public Controller {
         sf::Keyboard::Scancode right;
         sf::Keyboard::Scancode boost;
     };
-    KeyboardController(const KeyboardControls& keys) : _keys(keys) {}
+    KeyboardController(GameResources& game_resources,
+                       const KeyboardControls& keys)
+        : _game_resources(game_resources), _keys(keys) {}
     void update(const Time&) override;
 
   private:
+    GameResources& _game_resources;
     KeyboardControls _keys;
 };
 
@@ -17,7 +17,9 @@ Food::Food(Vec2 position, double radius, Time bonusExpired, sf::Color color)
       _age(0),
       _bonus_expire(bonusExpired),
       _original_radius(radius),
-      _start_of_decay(0) {
+      _start_of_decay(0),
+      _previous_rotation(0),
+      _previous_scale(1) {
     auto [h, s, l] = hsl_from_rgb(color.r, color.g, color.b);
     _color_hue = h;
     _color_saturation = s;
@@ -46,7 +48,9 @@ void Food::decay(Time elapsedTime) {
     auto decayTime = _age - _start_of_decay;
     const Time timeForDying = time_from_seconds(0.25);
 
-    setRadius(_original_radius * (timeForDying - decayTime) / timeForDying);
+    // Scaling leaves the geometry of the shape as it is
+    float scale = (timeForDying - decayTime) / timeForDying;
+    setScale(scale, scale);
     if (decayTime >= timeForDying)
         state(Dead);
 }
@@ -62,7 +66,23 @@ double Food::score_value() const {
     return score;
 }
 
+double Food::interpolated_rotation(double interpolation) const {
+    // Turns the short way, the rotation is kept within [0, 360)
+    double change = getRotation() - _previous_rotation;
+    if (change > 180)
+        change -= 360;
+    else if (change < -180)
+        change += 360;
+    return _previous_rotation + interpolation * change;
+}
+
+double Food::interpolated_scale(double interpolation) const {
+    return _previous_scale + interpolation * (getScale().x - _previous_scale);
+}
+
 void Food::update(Time elapsed_time) {
+    _previous_rotation = getRotation();
+    _previous_scale = getScale().x;
     _age += elapsed_time;
     rotate(2 * nominal_food_radius / sf::CircleShape::getRadius());
     if (state() == Dead) {
@@ -18,6 +18,10 @@ class Food : public GameObject, public sf::CircleShape, public CollidingBody, pu
     std::shared_ptr<const VVipers::Shape> segment_shape(size_t index) const override;
     sf::Color color() const;
     bool is_bonus_eligible() const;
+    /** The rotation and scale between the last two updates, 0 being the
+     * previous and 1 the latest **/
+    double interpolated_rotation(double interpolation) const;
+    double interpolated_scale(double interpolation) const;
     size_t number_of_segments() const override {return 1;}
     double score_value() const;
     void update(Time elapsedTime);
@@ -35,6 +39,8 @@ class Food : public GameObject, public sf::CircleShape, public CollidingBody, pu
     double _color_lightness;
     const double _original_radius;
     Time _start_of_decay;
+    double _previous_rotation;  // Before the last update
+    double _previous_scale;
 };
 
 }  // namespace VVipers
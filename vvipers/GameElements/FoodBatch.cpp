@@ -0,0 +1,64 @@
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <cmath>
+#include <vvipers/GameElements/FoodBatch.hpp>
+#include <vvipers/Utilities/VVMath.hpp>
+
+namespace VVipers {
+
+void FoodBatch::pack(const std::vector<const Food*>& food,
+                     double interpolation) {
+    size_t number_of_vertices = 0;
+    // Every edge has one fill triangle and two outline triangles
+    for (auto item : food)
+        number_of_vertices += 9 * item->getPointCount();
+    _vertices.resize(number_of_vertices);
+    size_t vertex_index = 0;
+    for (auto item : food)
+        write_pellet(*item, interpolation, vertex_index);
+}
+
+/* Places the corners like sf::CircleShape does, starting at the top. The
+ * outline corners are moved out along the corner directions far enough for the
+ * edges to be outline thickness away. */
+void FoodBatch::write_pellet(const Food& food, double interpolation,
+                             size_t& vertex_index) {
+    const size_t number_of_points = food.getPointCount();
+    Vec2 center = food.getPosition();
+    const double radius =
+        food.getRadius() * food.interpolated_scale(interpolation);
+    const double outline_radius =
+        radius + food.getOutlineThickness() / std::cos(pi / number_of_points);
+    const double rotation =
+        rad_from_deg(food.interpolated_rotation(interpolation));
+    const sf::Color fill = food.getFillColor();
+    const sf::Color outline = food.getOutlineColor();
+
+    auto corner = [&](size_t point, double corner_radius) {
+        double angle = point * twopi / number_of_points - pi / 2 + rotation;
+        return center +
+               corner_radius * Vec2(std::cos(angle), std::sin(angle));
+    };
+    Vec2 inner = corner(0, radius);
+    Vec2 outer = corner(0, outline_radius);
+    for (size_t point = 1; point <= number_of_points; ++point) {
+        Vec2 next_inner = corner(point % number_of_points, radius);
+        Vec2 next_outer = corner(point % number_of_points, outline_radius);
+        _vertices[vertex_index++] = sf::Vertex(center, fill);
+        _vertices[vertex_index++] = sf::Vertex(inner, fill);
+        _vertices[vertex_index++] = sf::Vertex(next_inner, fill);
+        _vertices[vertex_index++] = sf::Vertex(inner, outline);
+        _vertices[vertex_index++] = sf::Vertex(outer, outline);
+        _vertices[vertex_index++] = sf::Vertex(next_outer, outline);
+        _vertices[vertex_index++] = sf::Vertex(inner, outline);
+        _vertices[vertex_index++] = sf::Vertex(next_outer, outline);
+        _vertices[vertex_index++] = sf::Vertex(next_inner, outline);
+        inner = next_inner;
+        outer = next_outer;
+    }
+}
+
+void FoodBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    target.draw(_vertices, states);
+}
+
+}  // namespace VVipers
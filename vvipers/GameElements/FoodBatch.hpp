@@ -0,0 +1,27 @@
+#pragma once
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <vector>
+#include <vvipers/GameElements/Food.hpp>
+
+namespace VVipers {
+
+/** Writes the pellets of all food, outlines included, into one vertex array
+ * so that they are drawn with a single call. The geometry is generated from
+ * the position, radius, rotation and colours of every food item. **/
+class FoodBatch : public sf::Drawable {
+  public:
+    /** Places the rotation and size of every item between its last two
+     * states according to interpolation **/
+    void pack(const std::vector<const Food*>& food, double interpolation = 1);
+    const sf::VertexArray& vertices() const { return _vertices; }
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+  private:
+    void write_pellet(const Food& food, double interpolation,
+                      size_t& vertex_index);
+    sf::VertexArray _vertices{sf::PrimitiveType::Triangles};
+};
+
+}  // namespace VVipers
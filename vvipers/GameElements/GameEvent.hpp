@@ -2,6 +2,8 @@
 
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Window/Keyboard.hpp>
+#include <functional>
+#include <memory>
 #include <vvipers/Utilities/Time.hpp>
 
 namespace VVipers {
@@ -23,6 +25,9 @@ class GameEvent {
         ObjectModified,
         Window
     };
+    /** Keep in step with the last EventType **/
+    static const size_t number_of_types =
+        static_cast<size_t>(EventType::Window) + 1;
     virtual GameEvent* clone() const = 0;
     EventType type() const { return _type; }
     virtual ~GameEvent() {};
@@ -92,6 +97,10 @@ class SceneEvent : public GameEvent {
     GameEvent* clone() const override { return new SceneEvent(*this); }
     const SceneEventType scene_event_type;
     std::shared_ptr<Scene> target_scene;
+    /** Creates target_scene if it is not set. New scenes lay out their texts
+     * with fonts the render thread may be drawing with, so the Engine runs
+     * this once nothing is being drawn. **/
+    std::function<std::shared_ptr<Scene>()> scene_factory;
 };
 
 class ScoringEvent : public GameEvent {
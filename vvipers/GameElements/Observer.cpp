@@ -1,28 +1,76 @@
+#include <algorithm>
 #include <vvipers/GameElements/Observer.hpp>
 
 namespace VVipers {
 
 Observable::~Observable() {
     /** The actual removal is only done by Observable::removeObserver() **/
-    while( _observers.begin() != _observers.end() )
-        remove_observer( _observers.begin()->first );
+    for (auto& observers : _observers)
+        while (!observers.empty()) {
+            if (observers.back())
+                remove_observer(observers.back());
+            else
+                observers.pop_back();
+        }
 }
 
 void Observable::add_observer(Observer* observer,
                              const std::set<GameEvent::EventType>& eventTypes) {
-    _observers[observer] = eventTypes;
+    erase_observer(observer);
+    for (auto type : eventTypes) {
+        _observers[static_cast<size_t>(type)].push_back(observer);
+        _observed_types |= type_bit(type);
+    }
     observer->_observing.insert(this);
 }
 
 void Observable::remove_observer(Observer* observer) {
-    _observers.erase(observer);
+    erase_observer(observer);
     observer->_observing.erase(this);
 }
 
+void Observable::erase_observer(Observer* observer) {
+    for (size_t type = 0; type < _observers.size(); ++type) {
+        auto& observers = _observers[type];
+        if (_sending) {
+            // Left as null so that send() does not skip the next observer
+            std::ranges::replace(observers, observer, nullptr);
+            continue;
+        }
+        std::erase_if(observers, [observer](Observer* other) {
+            return other == observer || !other;
+        });
+        if (observers.empty())
+            _observed_types &= ~(1u << type);
+    }
+}
+
+void Observable::flush_notifications() {
+    // Swapped out since observers may cause new events
+    std::vector<std::unique_ptr<GameEvent> > events;
+    events.swap(_deferred_events);
+    for (auto& event : events)
+        send(*event);
+}
+
 void Observable::notify(const GameEvent& event) const {
-    for (auto& observer : _observers)
-        if (observer.second.contains(event.type()))
-            observer.first->on_notify(event);
+    if (_deferring)
+        _deferred_events.emplace_back(event.clone());
+    else
+        send(event);
+}
+
+void Observable::send(const GameEvent& event) const {
+    if (!(_observed_types & type_bit(event.type())))
+        return;
+    auto& observers = _observers[static_cast<size_t>(event.type())];
+    // Indexed since an observer may add another one while notified, and
+    // removed ones are null until the next change outside of send()
+    ++_sending;
+    for (size_t i = 0; i < observers.size(); ++i)
+        if (observers[i])
+            observers[i]->on_notify(event);
+    --_sending;
 }
 
 Observer::~Observer() {
@@ -1,28 +1,49 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <set>
+#include <vector>
 #include <vvipers/GameElements/GameEvent.hpp>
 
 namespace VVipers {
 
 class Observer;
 
+/** Keeps one list per EventType, so an event only visits the observers that
+ * want it. A mask of the types with observers rejects the others at once. **/
 class Observable {
   public:
     /** The dtor will remove all observers **/
     virtual ~Observable();
-    /** Will also update the observer's list of Observables **/
+    /** Will also update the observer's list of Observables. Replaces the event
+     * types of an observer added before. **/
     void add_observer(Observer* observer,
                       const std::set<GameEvent::EventType>& eventTypes);
     /** Will also update the observer's list of Observables **/
     void remove_observer(Observer* observer);
+    /** While deferred, events are queued instead of sent, which allows the
+     * Observable to be updated outside the thread of its observers. **/
+    void defer_notifications(bool defer) { _deferring = defer; }
+    /** Sends the queued events in the order they were queued **/
+    void flush_notifications();
 
   protected:
     void notify(const GameEvent& event) const;
 
   private:
-    std::map<Observer*, std::set<GameEvent::EventType> > _observers;
+    void send(const GameEvent& event) const;
+    void erase_observer(Observer* observer);
+    static uint32_t type_bit(GameEvent::EventType type) {
+        return 1u << static_cast<size_t>(type);
+    }
+
+    std::array<std::vector<Observer*>, GameEvent::number_of_types> _observers;
+    uint32_t _observed_types = 0;
+    mutable size_t _sending = 0;  // Nested calls to send()
+    bool _deferring = false;
+    mutable std::vector<std::unique_ptr<GameEvent> > _deferred_events;
 };
 
 class Observer {
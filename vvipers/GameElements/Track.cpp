@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cmath>
 #include <deque>
 #include <iterator>
 #include <sstream>
@@ -9,37 +10,58 @@
 
 namespace VVipers {
 
-TemporalTrack::TemporalTrack(const Vec2& p1, const Time& t1, const Vec2& p2,
-                             const Time& t2) {
+template <typename Point>
+BasicTemporalTrack<Point>::BasicTemporalTrack(const Vec2& p1, const Time& t1,
+                                              const Vec2& p2, const Time& t2)
+  : m_points(&m_memory),
+    m_origin(p1),
+    m_epoch(t1),
+    m_head(p1, t1, (p1 - p2) / time_as_seconds(t1 - t2),
+           time_from_seconds(0.)),
+    m_buckets(&m_memory) {
   if (t1 <= t2)
     throw std::runtime_error(
       "Trying to initiate a temporal track out of temporal order.");
-  Vec2 v = (p1 - p2) / time_as_seconds(t1 - t2);
-  m_points.emplace(m_points.cend(), p1, t1, v, time_from_seconds(0.));
-  m_points.emplace(m_points.cend(), p2, t2, v, t1 - t2);
+  m_points.emplace(m_points.cend(), encode(m_head));
+  m_points.emplace(m_points.cend(), encode(TemporalTrackPoint(
+                                      p2, t2, m_head.velocity, t1 - t2)));
+  rebuild_index();
 }
 
-void TemporalTrack::create_back(const Vec2& v, const Time& delta) {
+template <typename Point>
+void BasicTemporalTrack<Point>::create_back(const Vec2& v, const Time& delta) {
   if (delta <= time_from_seconds(0.))
     throw std::runtime_error(
       "Trying to create a temporal track point out of temporal "
       "order.");
-  m_points.emplace(m_points.cend(), tail() + v * time_as_seconds(delta),
-                   tail().spawn_time - delta, v, delta);
+  auto old_tail = tail();
+  m_points.emplace(m_points.cend(),
+                   encode(TemporalTrackPoint(
+                     old_tail + v * time_as_seconds(delta),
+                     old_tail.spawn_time - delta, v, delta)));
+  // Rarely used, so the index is simply rebuilt
+  rebuild_index();
 }
 
-void TemporalTrack::create_front(const Vec2& v, const Time& delta) {
+template <typename Point>
+void BasicTemporalTrack<Point>::create_front(const Vec2& v, const Time& delta) {
   if (delta <= time_from_seconds(0.))
     throw std::runtime_error(
       "Trying to create a temporal track point out of temporal "
       "order.");
-  m_points.front().delta_t = delta;
-  m_points.front().velocity = v;
-  m_points.emplace(m_points.cbegin(), head() + v * time_as_seconds(delta),
-                   head().spawn_time + delta, v, time_from_seconds(0.));
+  m_head.delta_t = delta;
+  m_head.velocity = v;
+  m_points.front() = encode(m_head);
+  m_head = TemporalTrackPoint(m_head + v * time_as_seconds(delta),
+                              m_head.spawn_time + delta, v,
+                              time_from_seconds(0.));
+  m_points.emplace(m_points.cbegin(), encode(m_head));
+  ++m_front_serial;
+  index_front_point(m_points.front().time(m_epoch));
 }
 
-Vec2 TemporalTrack::velocity(const Time& t) const {
+template <typename Point>
+Vec2 BasicTemporalTrack<Point>::velocity(const Time& t) const {
   if (m_points.size() < 2) {
     tag_error("Cannot compute a direction with < 2 TrackPoints.");
     throw std::runtime_error(
@@ -49,18 +71,21 @@ Vec2 TemporalTrack::velocity(const Time& t) const {
   auto tp = at_or_before(t);
   if (tp == m_points.cend())
     tp = std::prev(tp);
-  return tp->velocity;
+  return decode(*tp).velocity;
 }
 
-double TemporalTrack::length() const {
+template <typename Point>
+double BasicTemporalTrack<Point>::length() const {
   double length = 0.;
-  for (auto& point : m_points) {
+  for (auto& stored_point : m_points) {
+    auto point = decode(stored_point);
     length += point.velocity.abs() * time_as_seconds(point.delta_t);
   }
   return length;
 }
 
-double TemporalTrack::length(const Time& t1, const Time& t2) const {
+template <typename Point>
+double BasicTemporalTrack<Point>::length(const Time& t1, const Time& t2) const {
   if (t1 < t2) {
     std::stringstream msg;
     msg << "Requesting length between t1 = " << t1 << " and t2 = " << t2
@@ -68,12 +93,11 @@ double TemporalTrack::length(const Time& t1, const Time& t2) const {
     tag_error(msg.str());
     throw std::runtime_error(msg.str());
   }
-  if (t1 > m_points.front().spawn_time || t2 < m_points.back().spawn_time) {
+  if (t1 > head_time() || t2 < tail_time()) {
     std::stringstream msg;
     msg << "Requesting length between t1 = " << t1 << " and t2 = " << t2
-        << ", which is outside viper time interval("
-        << m_points.back().spawn_time << " - " << m_points.front().spawn_time
-        << ").";
+        << ", which is outside viper time interval(" << tail_time() << " - "
+        << head_time() << ").";
     tag_error(msg.str());
     throw std::runtime_error(msg.str());
   }
@@ -86,40 +110,134 @@ double TemporalTrack::length(const Time& t1, const Time& t2) const {
   // p2 is guaranteed to exist and spawned before t1
   auto p2 = at_or_before(t2);
   for (auto iter = p2; iter != p1; --iter) {
-    length += iter->velocity.abs() * time_as_seconds(iter->delta_t);
+    auto point = decode(*iter);
+    length += point.velocity.abs() * time_as_seconds(point.delta_t);
   }
-  auto tmp1 = std::next(p1);
-  length -= tmp1->velocity.abs() * time_as_seconds(p1->spawn_time - t1);
-  length -= p2->velocity.abs() * time_as_seconds(t2 - p2->spawn_time);
+  auto first = decode(*p1);
+  auto last = decode(*p2);
+  length -= decode(*std::next(p1)).velocity.abs() *
+            time_as_seconds(first.spawn_time - t1);
+  length -= last.velocity.abs() * time_as_seconds(t2 - last.spawn_time);
 
   return length;
 }
 
-Vec2 TemporalTrack::position(const Time& t) const {
+template <typename Point>
+Vec2 BasicTemporalTrack<Point>::position(const Time& t) const {
   auto p = at_or_before(t);
   if (p == m_points.cend())
-    p = t > head().spawn_time ? m_points.cbegin() : std::prev(p);
+    p = t > head_time() ? m_points.cbegin() : std::prev(p);
+
+  auto point = decode(*p);
+  return point + point.velocity * time_as_seconds(t - point.spawn_time);
+}
+
+template <typename Point>
+int64_t BasicTemporalTrack<Point>::bucket(const Time& t) const {
+  return std::floor((t - m_epoch) / bucket_duration);
+}
+
+// Updates the index after a new point has been added to the front
+template <typename Point>
+void BasicTemporalTrack<Point>::index_front_point(const Time& front_time) {
+  int64_t front_bucket = bucket(front_time);
+  if (m_buckets.empty()) {
+    m_first_bucket = front_bucket;
+    m_buckets.push_back(m_front_serial);
+    return;
+  }
+  int64_t last_bucket = m_first_bucket + m_buckets.size() - 1;
+  if (front_bucket == last_bucket) {
+    m_buckets.back() = m_front_serial;
+    return;
+  }
+  // Buckets without any points of their own refer to the previous head
+  for (auto b = last_bucket + 1; b < front_bucket; ++b)
+    m_buckets.push_back(m_front_serial - 1);
+  m_buckets.push_back(m_front_serial);
+}
+
+template <typename Point>
+void BasicTemporalTrack<Point>::rebuild_index() {
+  m_buckets.clear();
+  m_front_serial = 0;
+  // Index the points one by one, starting with the tail, as if they were
+  // created with create_front. The serial counts up from the tail to the head.
+  for (auto iter = m_points.crbegin(); iter != m_points.crend(); ++iter) {
+    if (iter != m_points.crbegin())
+      ++m_front_serial;
+    index_front_point(iter->time(m_epoch));
+  }
+}
+
+// Removes entries for buckets that only contained removed points
+template <typename Point>
+void BasicTemporalTrack<Point>::trim_index() {
+  uint64_t tail_serial = m_front_serial - (m_points.size() - 1);
+  while (m_buckets.front() < tail_serial) {
+    m_buckets.pop_front();
+    ++m_first_bucket;
+  }
+}
 
-  return *p + p->velocity * time_as_seconds(t - p->spawn_time);
+// Find TemporalTrackPoint with spawn_time <= t using the index
+template <typename Point>
+typename BasicTemporalTrack<Point>::const_iterator
+BasicTemporalTrack<Point>::at_or_before(const Time& t) const {
+  int64_t t_bucket = bucket(t);
+  int64_t last_bucket = m_first_bucket + m_buckets.size() - 1;
+  // All points are older than the bucket
+  if (t_bucket > last_bucket)
+    return m_points.cbegin();
+  // All points are newer than the bucket
+  if (t_bucket < m_first_bucket)
+    return m_points.cend();
+  // The result is spawned before the end of the bucket, but not earlier than
+  // the newest point spawned before the bucket
+  auto start_iter = iterator_from_serial(m_buckets[t_bucket - m_first_bucket]);
+  auto end_iter =
+    t_bucket == m_first_bucket
+      ? m_points.cend()
+      : std::next(
+          iterator_from_serial(m_buckets[t_bucket - m_first_bucket - 1]));
+  auto iter = at_or_before(t, start_iter, end_iter);
+  return iter == end_iter ? m_points.cend() : iter;
+}
+
+// Find TemporalTrackPoint with spawn_time >= t using the index
+template <typename Point>
+typename BasicTemporalTrack<Point>::const_iterator
+BasicTemporalTrack<Point>::at_or_later(const Time& t) const {
+  auto iter = at_or_before(t);
+  if (iter != m_points.cend() && iter->time(m_epoch) == t)
+    return iter;
+  // The head is spawned before t
+  if (iter == m_points.cbegin())
+    return m_points.cend();
+  return std::prev(iter);
 }
 
 // Find TemporalTrackPoint with spawn_time <= t
-tt_const_iter TemporalTrack::at_or_before(const Time& t,
-                                          const tt_const_iter& start_iter,
-                                          const tt_const_iter& end_iter) const {
+template <typename Point>
+typename BasicTemporalTrack<Point>::const_iterator
+BasicTemporalTrack<Point>::at_or_before(const Time& t,
+                                        const const_iterator& start_iter,
+                                        const const_iterator& end_iter) const {
   return std::lower_bound(start_iter, end_iter, t,
-                          [](const TemporalTrackPoint& tp, const Time& t) {
-                            return tp.spawn_time > t;
+                          [this](const Point& tp, const Time& t) {
+                            return tp.time(m_epoch) > t;
                           });
 }
 
 // Find TemporalTrackPoint with spawn_time >= t
-tt_const_iter TemporalTrack::at_or_later(const Time& t,
-                                         const tt_const_iter& start_iter,
-                                         const tt_const_iter& end_iter) const {
-  tt_const_iter iter = std::upper_bound(
-    start_iter, end_iter, t, [](const Time& t, const TemporalTrackPoint& tp) {
-      return tp.spawn_time < t;
+template <typename Point>
+typename BasicTemporalTrack<Point>::const_iterator
+BasicTemporalTrack<Point>::at_or_later(const Time& t,
+                                       const const_iterator& start_iter,
+                                       const const_iterator& end_iter) const {
+  const_iterator iter = std::upper_bound(
+    start_iter, end_iter, t, [this](const Time& t, const Point& tp) {
+      return tp.time(m_epoch) < t;
     });
   /* Upper bound returns a TemporalTrackPoint with a spawn_time < t.
    * If that is the first iterator in the interval there is no element with
@@ -128,35 +246,48 @@ tt_const_iter TemporalTrack::at_or_later(const Time& t,
   if (iter == start_iter)
     return m_points.cend();
   iter = std::prev(iter);
-  if (iter->spawn_time < t)
+  if (iter->time(m_epoch) < t)
     return m_points.cend();
   return iter;
 }
 
-void TemporalTrack::pop_back() {
+template <typename Point>
+void BasicTemporalTrack<Point>::pop_back() {
   if (m_points.size() <= 2)
     throw std::runtime_error(
       "Trying to reduce temporal track length to less than 2.");
-  return m_points.pop_back();
+  m_points.pop_back();
+  trim_index();
 }
 
-void TemporalTrack::pop_front() {
+template <typename Point>
+void BasicTemporalTrack<Point>::pop_front() {
   if (m_points.size() <= 2)
     throw std::runtime_error(
       "Trying to reduce temporal track length to less than 2.");
-  return m_points.pop_front();
+  m_points.pop_front();
+  m_head = decode(m_points.front());
+  rebuild_index();
 }
 
-void TemporalTrack::remove_trailing(const Time& t) {
+template <typename Point>
+void BasicTemporalTrack<Point>::remove_trailing(const Time& t) {
   // Never remove the first to points
   auto first_to_erase = at_or_before(t, m_points.cbegin() + 2, m_points.cend());
   m_points.erase(first_to_erase, m_points.cend());
+  trim_index();
 }
 
-std::ostream& operator<<(std::ostream& os, const TemporalTrack& t) {
+template <typename Point>
+std::ostream& operator<<(std::ostream& os, const BasicTemporalTrack<Point>& t) {
   os << "Track size: " << t.size() << ", track length: " << t.length()
      << std::endl;
   return os;
 }
 
+template class BasicTemporalTrack<TemporalTrackPoint>;
+template class BasicTemporalTrack<CompactTemporalTrackPoint>;
+template std::ostream& operator<<(std::ostream&, const TemporalTrack&);
+template std::ostream& operator<<(std::ostream&, const CompactTemporalTrack&);
+
 }  // namespace VVipers
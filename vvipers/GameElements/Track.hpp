@@ -3,7 +3,9 @@
 #include <pthread.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <memory_resource>
 #include <vvipers/Utilities/Time.hpp>
 #include <vvipers/Utilities/Vec2.hpp>
 #include <vvipers/Utilities/debug.hpp>
@@ -23,6 +25,15 @@ class TemporalTrackPoint : public Vec2 {
                this->y == right.y && this->velocity == right.velocity;
     }
 
+    /** Storage interface used by BasicTemporalTrack. Full precision points
+     * are stored as they are and ignore the origin and epoch of the track. **/
+    static TemporalTrackPoint encode(const TemporalTrackPoint& point,
+                                     const Vec2&, const Time&) {
+        return point;
+    }
+    TemporalTrackPoint decode(const Vec2&, const Time&) const { return *this; }
+    Time time(const Time&) const { return spawn_time; }
+
     Time spawn_time;
     Vec2 velocity;
     Time delta_t;
@@ -33,27 +44,66 @@ inline std::ostream& operator<<(std::ostream& os, const TemporalTrackPoint& p) {
               << ", delta_t = " << p.delta_t;
 }
 
-typedef std::deque<TemporalTrackPoint>::const_iterator tt_const_iter;
+/** Single precision storage of a TemporalTrackPoint, half its size. Position
+ * and spawn time are stored relative to the origin and epoch of the track,
+ * which keeps the rounding error far below a pixel within a bounded arena. **/
+class CompactTemporalTrackPoint {
+  public:
+    static CompactTemporalTrackPoint encode(const TemporalTrackPoint& point,
+                                            const Vec2& origin,
+                                            const Time& epoch) {
+        return {float(point.x - origin.x), float(point.y - origin.y),
+                float(time_as_seconds(point.spawn_time - epoch)),
+                float(point.velocity.x), float(point.velocity.y),
+                float(time_as_seconds(point.delta_t))};
+    }
+    TemporalTrackPoint decode(const Vec2& origin, const Time& epoch) const {
+        return TemporalTrackPoint(origin + Vec2(x, y), time(epoch),
+                                  Vec2(velocity_x, velocity_y), Time(delta_t));
+    }
+    Time time(const Time& epoch) const { return epoch + Time(spawn_time); }
+
+    float x, y;        // px relative to origin
+    float spawn_time;  // s relative to epoch
+    float velocity_x, velocity_y;  // px/s
+    float delta_t;                 // s
+};
 
 /// The TemporalTrack promises to allways have at least two TemporalTrackPoints.
 /// Therefore, the constructor needs two initial points and any method of
 /// removing points must make sure to not remove too many.
-class TemporalTrack {
+/// The Point type decides how the points are stored. Points are converted to
+/// TemporalTrackPoints at the API boundary, so all positions and times going
+/// in and out of the track are in full precision.
+/// Lookups over the whole track start from a time-bucketed index, with one
+/// entry per bucket_duration of track time, instead of searching all points.
+/// The points and the index are allocated from a pool owned by the track, so
+/// a track that is trimmed as fast as it grows stops allocating memory.
+template <typename Point>
+class BasicTemporalTrack {
   public:
-    TemporalTrack(const Vec2& p1, const Time& t1, const Vec2& p2,
-                  const Time& t2);
+    typedef typename std::pmr::deque<Point>::const_iterator const_iterator;
+
+    BasicTemporalTrack(const Vec2& p1, const Time& t1, const Vec2& p2,
+                       const Time& t2);
+    BasicTemporalTrack(const BasicTemporalTrack&) = delete;
+    BasicTemporalTrack& operator=(const BasicTemporalTrack&) = delete;
     size_t size() const { return m_points.size(); }
     double length() const;
     double length(const Time& from, const Time& to) const;
 
-    tt_const_iter begin() const { return m_points.cbegin(); }
-    tt_const_iter end() const { return m_points.cend(); }
-    const TemporalTrackPoint& head() const { return m_points.front(); }
-    const TemporalTrackPoint& tail() const { return m_points.back(); }
-    const Time& head_time() const { return m_points.front().spawn_time; }
-    const Time& tail_time() const { return m_points.back().spawn_time; }
-    const Vec2& head_position() const { return m_points.front(); }
-    const Vec2& tail_position() const { return m_points.back(); }
+    const_iterator begin() const { return m_points.cbegin(); }
+    const_iterator end() const { return m_points.cend(); }
+    /** Converts a stored point to full precision. **/
+    TemporalTrackPoint decode(const Point& point) const {
+        return point.decode(m_origin, m_epoch);
+    }
+    const TemporalTrackPoint& head() const { return m_head; }
+    TemporalTrackPoint tail() const { return decode(m_points.back()); }
+    const Time& head_time() const { return m_head.spawn_time; }
+    Time tail_time() const { return m_points.back().time(m_epoch); }
+    const Vec2& head_position() const { return m_head; }
+    Vec2 tail_position() const { return tail(); }
     Vec2 position(const Time& t) const;
     Vec2 velocity(const Time& t) const;
 
@@ -67,21 +117,51 @@ class TemporalTrack {
     // Will always leave a minimum of two points.
     void pop_front();
 
-    tt_const_iter at_or_before(const Time& t, const tt_const_iter& start,
-                               const tt_const_iter& end) const;
-    tt_const_iter at_or_later(const Time& t, const tt_const_iter& start,
-                              const tt_const_iter& end) const;
-    tt_const_iter at_or_before(const Time& t) const {
-        return at_or_before(t, m_points.cbegin(), m_points.cend());
+    const_iterator at_or_before(const Time& t, const const_iterator& start,
+                                const const_iterator& end) const;
+    const_iterator at_or_later(const Time& t, const const_iterator& start,
+                               const const_iterator& end) const;
+    const_iterator at_or_before(const Time& t) const;
+    const_iterator at_or_later(const Time& t) const;
+
+    static constexpr Time bucket_duration = Time(0.025);
+
+  private:
+    Point encode(const TemporalTrackPoint& point) const {
+        return Point::encode(point, m_origin, m_epoch);
     }
-    tt_const_iter at_or_later(const Time& t) const {
-        return at_or_later(t, m_points.cbegin(), m_points.end());
+    int64_t bucket(const Time& t) const;
+    const_iterator iterator_from_serial(uint64_t serial) const {
+        return m_points.cbegin() + (m_front_serial - serial);
     }
+    void index_front_point(const Time& front_time);
+    void rebuild_index();
+    void trim_index();
 
-  private:
-    std::deque<TemporalTrackPoint> m_points;
+    // Must outlive the containers using it
+    std::pmr::unsynchronized_pool_resource m_memory;
+    std::pmr::deque<Point> m_points;
+    // Reference position and time for relative storage
+    Vec2 m_origin;
+    Time m_epoch;
+    // Full precision copy of the front point. New points are created from it
+    // so that rounding errors in the storage never accumulate.
+    TemporalTrackPoint m_head;
+
+    /* Every point gets a serial number, increasing towards the head, so that
+     * index entries survive points being added to the front of the deque.
+     * m_buckets[i] holds the serial of the newest point spawned before the end
+     * of bucket m_first_bucket + i. */
+    uint64_t m_front_serial;
+    int64_t m_first_bucket;
+    std::pmr::deque<uint64_t> m_buckets;
 };
 
-std::ostream& operator<<(std::ostream& os, const TemporalTrack& t);
+typedef BasicTemporalTrack<TemporalTrackPoint> TemporalTrack;
+typedef BasicTemporalTrack<CompactTemporalTrackPoint> CompactTemporalTrack;
+typedef TemporalTrack::const_iterator tt_const_iter;
+
+template <typename Point>
+std::ostream& operator<<(std::ostream& os, const BasicTemporalTrack<Point>& t);
 
 }  // namespace VVipers
@@ -2,10 +2,13 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <algorithm>
+#include <cmath>
 #include <memory>
+#include <type_traits>
 #include <vector>
 #include <vvipers/GameElements/Viper.hpp>
 #include <vvipers/Utilities/VVColor.hpp>
+#include <vvipers/Utilities/Profiler.hpp>
 #include <vvipers/Utilities/Vec2.hpp>
 #include <vvipers/Utilities/debug.hpp>
 #include <vvipers/config.hpp>
@@ -18,6 +21,16 @@ namespace VVipers {
 
 using namespace std::chrono_literals;
 
+namespace {
+// The chunk of the ring a body segment belongs to, rounding down also for
+// segments before time zero
+int64_t ring_chunk(int64_t segment_index) {
+  const int64_t size = Viper::segments_per_chunk;
+  return segment_index >= 0 ? segment_index / size
+                            : (segment_index + 1) / size - 1;
+}
+}  // namespace
+
 Viper::Viper(std::shared_ptr<const ViperConfiguration> configuration,
              const Vec2& tail_position, double angle,
              double number_of_body_segments)
@@ -27,7 +40,17 @@ Viper::Viper(std::shared_ptr<const ViperConfiguration> configuration,
     _boost_increase(0.),
     _boost_charge(0),
     _boost_recharge_cooldown(0.),
-    _growth(0.) {
+    _growth(0.),
+    _dinner_cursor(0),
+    _number_of_polygons(0),
+    _first_body_segment(0),
+    _ring_position(0),
+    _chunks_before_ring(0),
+    _front_body_segments(0),
+    _body_vertex_begin(0),
+    _ring_vertex_begin(0),
+    _mesh_outdated(true),
+    _detail_level(0) {
   _boost_charge = _viper_configuration->boost_max_charge;
   _nominalSpeed = _viper_configuration->nominal_speed;
   _speed = _nominalSpeed;
@@ -39,9 +62,10 @@ Viper::Viper(std::shared_ptr<const ViperConfiguration> configuration,
   Vec2 direction = Vec2(1, 0).rotate(angle);
   double length = time_as_seconds(_temporal_length) * speed();
   auto viper_vector = length * direction;
-  _track = std::unique_ptr<TemporalTrack>(
-    new TemporalTrack(tail_position + viper_vector, _temporal_length,
-                      tail_position, time_from_seconds(0)));
+  _track = std::unique_ptr<ViperTrack>(
+    new ViperTrack(tail_position + viper_vector, _temporal_length,
+                   tail_position, time_from_seconds(0)));
+  _previous_head_position = _track->head_position();
   _triangle_strip_head.texture = _viper_configuration->head_texture;
   _triangle_strip_body.texture = _viper_configuration->body_texture;
   _triangle_strip_tail.texture = _viper_configuration->tail_texture;
@@ -63,7 +87,13 @@ void Viper::die(const Time& elapsed_time) {
 }
 
 void Viper::add_growth(Time howMuch, Time when, sf::Color color) {
-  _dinner_times[when] = {howMuch, color};
+  // Keeps the dinners sorted by time
+  auto iter = std::ranges::lower_bound(_dinner_times, when, {}, &Dinner::time);
+  if (iter != _dinner_times.end() && iter->time == when)
+    *iter = {when, howMuch, color};
+  else
+    _dinner_times.insert(iter, {when, howMuch, color});
+  _mesh_outdated = true;
 }
 
 double Viper::length() const {
@@ -83,23 +113,49 @@ void Viper::clean_up_trailing_temporal_track_points() {
 void Viper::clean_up_dinner_times() {
   // Slightly wasteful but there will never be more than a handful dinner
   // times stored at the same time.
-  for (auto& dinnerTime : _dinner_times)
-    if (dinnerTime.first < _track->tail_time()) {
-      _growth += dinnerTime.second.amount;
-      dinnerTime.second.amount = time_from_seconds(0);
+  for (auto& dinner : _dinner_times)
+    if (dinner.time < _track->tail_time() &&
+        dinner.amount > time_from_seconds(0)) {
+      _growth += dinner.amount;
+      dinner.amount = time_from_seconds(0);
+      _mesh_outdated = true;
     }
   // This loop can only remove a maximum of one time per update. But that's
   // fine
-  for (auto& dinnerTime : _dinner_times)
+  for (auto iter = _dinner_times.begin(); iter != _dinner_times.end(); ++iter)
     // Times 10 give us some margin but it would be nicer to specify
     // exactly...
-    if (dinnerTime.first + 10 * _viper_configuration->body_duration <
+    if (iter->time + 10 * _viper_configuration->body_duration <
         _track->tail_time()) {
-      _dinner_times.erase(dinnerTime.first);
+      _dinner_times.erase(iter);
+      _mesh_outdated = true;
       break;
     }
 }
 
+void Viper::set_detail_level(size_t level) {
+  level = std::min(level, ViperConfiguration::number_of_detail_levels - 1);
+  if (level != _detail_level) {
+    _detail_level = level;
+    _mesh_outdated = true;
+  }
+}
+
+size_t Viper::estimated_vertex_count(size_t level) const {
+  level = std::min(level, ViperConfiguration::number_of_detail_levels - 1);
+  const auto& configuration = *_viper_configuration;
+  double number_of_body_segments =
+    std::max(_temporal_length - configuration.head_duration -
+               configuration.tail_duration,
+             time_from_seconds(0)) /
+    configuration.body_duration;
+  // Every node gives two vertices and consecutive body segments share a node
+  return 2 * (configuration.head_node_levels[level].size() + 1 +
+              std::ceil(number_of_body_segments) *
+                (configuration.body_node_levels[level].size() - 1) +
+              configuration.tail_node_levels[level].size());
+}
+
 Time Viper::boost_max() const { return _viper_configuration->boost_max_charge; }
 
 void Viper::grow(const Time& elapsed_time) {
@@ -115,10 +171,12 @@ double Viper::max_angular_speed() const {
 }
 
 void Viper::update(Time elapsed_time) {
+  PROFILE_ZONE("Viper update");
   if (state() == Dead) {
     notify(DestroyEvent(this));
     return;
   }
+  _previous_head_position = _track->head_position();
   if (state() == Dying) {
     die(elapsed_time);  // Allow the viper to die for a while
   } else {
@@ -131,6 +189,12 @@ void Viper::update(Time elapsed_time) {
   clean_up_dinner_times();
 }
 
+Capsule Viper::swept_head() const {
+  const auto& nodes = _viper_configuration->head_node_tables[_detail_level];
+  double tip_radius = std::abs(nodes.width_factor.front()) / _speed;
+  return Capsule(_previous_head_position, _track->head_position(), tip_radius);
+}
+
 void Viper::add_boost_charge(Time charge) {
   auto oldCharge = _boost_charge;
   _boost_charge += charge;
@@ -182,10 +246,108 @@ void Viper::update_motion(const Time& elapsed_time) {
   update_angle(elapsed_time);
 }
 
+/* The arena draws the vipers without any transform, so the view bounds are
+ * in world coordinates. */
 void Viper::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-  _triangle_strip_head.draw(target, states);
-  _triangle_strip_body.draw(target, states);
-  _triangle_strip_tail.draw(target, states);
+  const auto& view = target.getView();
+  BoundingBox view_box(Vec2(view.getCenter()), Vec2(view.getSize()));
+  visible_strips(view_box, [&](const TriangleStripArray& strip, size_t begin,
+                               size_t end) {
+    strip.draw_range(target, states, begin, end);
+  });
+}
+
+// Body chunks outside the view are left out
+void Viper::visible_strips(
+  const BoundingBox& view_box,
+  const std::function<void(const TriangleStripArray&, size_t, size_t)>&
+    strip_range) const {
+  strip_range(_triangle_strip_head, 0, _triangle_strip_head.vertices.size());
+
+  size_t first_body_segment = _first_body_segment;
+  size_t end_body_segment =
+    first_body_segment + _body_vertex_ends.size() + _body_segments.size();
+  // Consecutive visible chunks are kept together
+  size_t range_begin = 0, range_end = 0;
+  for (size_t chunk = 0; chunk < number_of_chunks(); ++chunk) {
+    auto [chunk_begin, chunk_end] = chunk_segments(chunk);
+    chunk_begin = std::max(chunk_begin, first_body_segment);
+    chunk_end = std::min(chunk_end, end_body_segment);
+    if (chunk_begin >= chunk_end ||
+        !view_box.overlap(chunk_bounding_box(chunk)))
+      continue;
+    size_t vertex_begin = body_vertex_begin(chunk_begin - first_body_segment);
+    if (range_end == 0 || vertex_begin + 2 != range_end) {
+      if (range_end > range_begin)
+        strip_range(_triangle_strip_body, range_begin, range_end);
+      range_begin = vertex_begin;
+    }
+    range_end = body_vertex_end(chunk_end - 1 - first_body_segment);
+  }
+  if (range_end > range_begin)
+    strip_range(_triangle_strip_body, range_begin, range_end);
+
+  strip_range(_triangle_strip_tail, 0, _triangle_strip_tail.vertices.size());
+}
+
+size_t Viper::body_vertex_begin(size_t body_segment) const {
+  return body_segment == 0 ? _body_vertex_begin
+                           : body_vertex_end(body_segment - 1) - 2;
+}
+
+size_t Viper::body_vertex_end(size_t body_segment) const {
+  if (body_segment < _front_body_segments)
+    return _body_vertex_ends[body_segment];
+  size_t ring_index = body_segment - _front_body_segments;
+  if (ring_index < _body_segments.size()) {
+    size_t nodes = _viper_configuration->body_node_tables[_detail_level].size();
+    return _ring_vertex_begin + 2 * nodes + ring_index * 2 * (nodes - 1);
+  }
+  return _body_vertex_ends[body_segment - _body_segments.size()];
+}
+
+std::shared_ptr<const Shape> Viper::segment_shape(size_t index) const {
+  if (index >= _ring_position) {
+    if (index - _ring_position < _body_segments.size())
+      return _body_segments[index - _ring_position].shape;
+    index -= _body_segments.size();
+  }
+  if (_viper_configuration->capsule_collision)
+    return _capsules[index];
+  return _polygons[index];
+}
+
+std::pair<size_t, size_t> Viper::chunk_segments(size_t chunk) const {
+  size_t ring_end = _ring_position + _body_segments.size();
+  if (chunk < _chunks_before_ring) {
+    size_t end = _body_segments.empty() ? number_of_segments() : _ring_position;
+    return {chunk * segments_per_chunk,
+            std::min((chunk + 1) * segments_per_chunk, end)};
+  }
+  chunk -= _chunks_before_ring;
+  if (chunk < _ring_chunk_boxes.size()) {
+    const int64_t size = segments_per_chunk;
+    int64_t newest = _body_segments.front().index;
+    int64_t oldest = _body_segments.back().index;
+    int64_t chunk_oldest =
+      (ring_chunk(newest) - static_cast<int64_t>(chunk)) * size;
+    int64_t chunk_newest = chunk_oldest + size - 1;
+    return {_ring_position + (newest - std::min(newest, chunk_newest)),
+            _ring_position + (newest - std::max(oldest, chunk_oldest)) + 1};
+  }
+  chunk -= _ring_chunk_boxes.size();
+  size_t begin = ring_end + chunk * segments_per_chunk;
+  return {begin, std::min(begin + segments_per_chunk, number_of_segments())};
+}
+
+BoundingBox Viper::chunk_bounding_box(size_t chunk) const {
+  if (chunk < _chunks_before_ring)
+    return _chunk_bounding_boxes[chunk];
+  chunk -= _chunks_before_ring;
+  if (chunk < _ring_chunk_boxes.size())
+    return _ring_chunk_boxes[chunk];
+  return _chunk_bounding_boxes[_chunks_before_ring + chunk -
+                               _ring_chunk_boxes.size()];
 }
 
 void Viper::create_vertex_vectors_and_polygons_for_body_part(
@@ -194,13 +356,13 @@ void Viper::create_vertex_vectors_and_polygons_for_body_part(
     return;
 
   TriangleStripArray* vertex_vector;
-  const std::vector<Vec2>* nodes;
+  const ViperConfiguration::NodeTable* nodes;
   size_t number_of_segments = 1;
   Time nominal_segment_duration;
   switch (viper_part) {
     case ViperPart::Head: {
       nominal_segment_duration = _viper_configuration->head_duration;
-      nodes = &_viper_configuration->head_nodes;
+      nodes = &_viper_configuration->head_node_tables[_detail_level];
       vertex_vector = &_triangle_strip_head;
       break;
     }
@@ -208,19 +370,18 @@ void Viper::create_vertex_vectors_and_polygons_for_body_part(
       number_of_segments =
         part_duration / _viper_configuration->body_duration + 1;
       nominal_segment_duration = _viper_configuration->body_duration;
-      nodes = &_viper_configuration->body_nodes;
+      nodes = &_viper_configuration->body_node_tables[_detail_level];
       vertex_vector = &_triangle_strip_body;
       break;
     }
     case ViperPart::Tail: {
       nominal_segment_duration = _viper_configuration->tail_duration;
-      nodes = &_viper_configuration->tail_nodes;
+      nodes = &_viper_configuration->tail_node_tables[_detail_level];
       vertex_vector = &_triangle_strip_tail;
       break;
     }
   }
 
-  Vec2 texture_size = vertex_vector->texture->getSize();
   for (size_t segment_index = 0; segment_index < number_of_segments;
        ++segment_index) {
     size_t nodes_shared_with_prev_segment = segment_index == 0 ? 0 : 1;
@@ -228,38 +389,374 @@ void Viper::create_vertex_vectors_and_polygons_for_body_part(
     Time segment_duration =
       std::min(nominal_segment_duration,
                part_duration - segment_index * nominal_segment_duration);
-
-    for (size_t node_index = nodes_shared_with_prev_segment;
-         node_index < nodes->size(); ++node_index) {
-      Time time = segment_start - segment_duration * (*nodes)[node_index].y;
-      Vec2 position = _track->position(time);
-      Vec2 velocity = _track->velocity(time);
-      Vec2 width = velocity.perpendicular() *
-                   _viper_configuration->nominal_speed *
-                   _viper_configuration->nominal_segment_width *
-                   (*nodes)[node_index].x / velocity.dot(velocity);
-
-      Vec2 texture_coordinates_right =
-        (Vec2(0.5f, segment_index) + (*nodes)[node_index]) * texture_size;
-      Vec2 texture_coordinates_left =
-        Vec2(texture_size.x - texture_coordinates_right.x,
-             texture_coordinates_right.y);
-
-      sf::Color color = calculate_vertex_color(time);
-
-      vertex_vector->vertices.emplace_back(position + width, color,
-                                           texture_coordinates_right);
-      vertex_vector->vertices.emplace_back(position - width, color,
-                                           texture_coordinates_left);
+    append_segment_vertices(vertex_vector->vertices, *nodes, segment_index,
+                            segment_start, segment_duration,
+                            nodes_shared_with_prev_segment);
+    add_segment_span(*nodes, segment_start, segment_duration);
+  }
+  for (size_t segment_index = 0; segment_index < number_of_segments;
+       ++segment_index) {
+    if (!_viper_configuration->capsule_collision) {
+      vertex_vector->polygon_corners(_corners, segment_index,
+                                     number_of_segments);
+      next_polygon().set_corners(_corners);
     }
+    if (viper_part == ViperPart::Body)
+      _body_vertex_ends.push_back(
+        vertex_vector->polygon_vertex_range(segment_index, number_of_segments)
+          .second);
+  }
+}
+
+/* The number of nodes is either a size_t or a std::integral_constant. In the
+ * latter case the compiler knows the trip count and can unroll the loop. */
+template <typename NodeCount>
+void Viper::append_nodes(std::vector<sf::Vertex>& vertices,
+                         const ViperConfiguration::NodeTable& nodes,
+                         NodeCount number_of_nodes, double texture_index,
+                         const Time& segment_start,
+                         const Time& segment_duration, size_t first_node) {
+  float texture_offset = texture_index * nodes.texture_height;
+  size_t vertex_index = vertices.size();
+  vertices.resize(vertex_index + 2 * (number_of_nodes - first_node));
+  for (size_t node_index = first_node; node_index < number_of_nodes;
+       ++node_index) {
+    Time time =
+      segment_start - segment_duration * nodes.time_fraction[node_index];
+    Vec2 position = _track->position(time);
+    Vec2 velocity = _track->velocity(time);
+    Vec2 width = velocity.perpendicular() * nodes.width_factor[node_index] /
+                 velocity.dot(velocity);
+    float texture_v = nodes.texture_v[node_index] + texture_offset;
+    sf::Color color = calculate_vertex_color(time);
+
+    vertices[vertex_index++] =
+      sf::Vertex(position + width, color,
+                 {nodes.texture_u_right[node_index], texture_v});
+    vertices[vertex_index++] =
+      sf::Vertex(position - width, color,
+                 {nodes.texture_u_left[node_index], texture_v});
+  }
+}
+
+void Viper::append_segment_vertices(std::vector<sf::Vertex>& vertices,
+                                    const ViperConfiguration::NodeTable& nodes,
+                                    double texture_index,
+                                    const Time& segment_start,
+                                    const Time& segment_duration,
+                                    size_t first_node) {
+  // Specialised for the node counts of the default model and its levels of
+  // detail
+  switch (nodes.size()) {
+    case 3:
+      append_nodes(vertices, nodes, std::integral_constant<size_t, 3>(),
+                   texture_index, segment_start, segment_duration, first_node);
+      break;
+    case 4:
+      append_nodes(vertices, nodes, std::integral_constant<size_t, 4>(),
+                   texture_index, segment_start, segment_duration, first_node);
+      break;
+    case 7:
+      append_nodes(vertices, nodes, std::integral_constant<size_t, 7>(),
+                   texture_index, segment_start, segment_duration, first_node);
+      break;
+    case 8:
+      append_nodes(vertices, nodes, std::integral_constant<size_t, 8>(),
+                   texture_index, segment_start, segment_duration, first_node);
+      break;
+    default:
+      append_nodes(vertices, nodes, nodes.size(), texture_index, segment_start,
+                   segment_duration, first_node);
+  }
+}
+
+// Samples one body segment into _segment_strip
+void Viper::sample_body_segment(double texture_index,
+                                const Time& segment_start,
+                                const Time& segment_duration) {
+  _segment_strip.vertices.clear();
+  append_segment_vertices(_segment_strip.vertices,
+                          _viper_configuration->body_node_tables[_detail_level],
+                          texture_index, segment_start, segment_duration, 0);
+}
+
+Viper::BodySegment Viper::create_body_segment(int64_t index) {
+  const Time& grid = _viper_configuration->body_duration;
+  // The texture index decreases towards the head, like the grid index
+  // increases, so that the texture runs continuously between segments
+  sample_body_segment(-index, (index + 1) * grid, grid);
+  std::shared_ptr<const Shape> shape;
+  if (_viper_configuration->capsule_collision)
+    shape = std::make_shared<Capsule>(create_capsule(
+      {(index + 1) * grid, grid,
+       &_viper_configuration->body_node_tables[_detail_level]}));
+  else
+    shape =
+      std::make_shared<Polygon>(_segment_strip.create_polygons(1).front());
+  return {index, shape, shape->bounding_box()};
+}
+
+/* Copies the segment in _segment_strip into the body strip next to the ring.
+ * Neighbouring segments share the node at their common boundary. */
+void Viper::push_body_segment(int64_t index, bool front) {
+  auto segment = create_body_segment(index);
+  const auto& segment_vertices = _segment_strip.vertices;
+  auto& vertices = _triangle_strip_body.vertices;
+  if (_body_segments.empty()) {
+    if (vertices.size() < _ring_vertex_begin + segment_vertices.size())
+      vertices.resize(_ring_vertex_begin + segment_vertices.size());
+    std::copy(segment_vertices.cbegin(), segment_vertices.cend(),
+              vertices.begin() + _ring_vertex_begin);
+    _ring_chunk_boxes.push_back(segment.bounding_box);
+    _body_segments.push_back(std::move(segment));
+    return;
+  }
+  size_t count = segment_vertices.size() - 2;
+  if (front) {
+    bool same_chunk =
+      ring_chunk(index) == ring_chunk(_body_segments.front().index);
+    reserve_front_vertices(count);
+    _ring_vertex_begin -= count;
+    std::copy(segment_vertices.cbegin(), segment_vertices.cend() - 2,
+              vertices.begin() + _ring_vertex_begin);
+    if (same_chunk)
+      _ring_chunk_boxes.front().include(segment.bounding_box);
+    else
+      _ring_chunk_boxes.push_front(segment.bounding_box);
+    _body_segments.push_front(std::move(segment));
+  } else {
+    bool same_chunk =
+      ring_chunk(index) == ring_chunk(_body_segments.back().index);
+    size_t ring_end = _ring_vertex_begin + ring_vertex_count();
+    if (vertices.size() < ring_end + count)
+      vertices.resize(ring_end + count);
+    std::copy(segment_vertices.cbegin() + 2, segment_vertices.cend(),
+              vertices.begin() + ring_end);
+    if (same_chunk)
+      _ring_chunk_boxes.back().include(segment.bounding_box);
+    else
+      _ring_chunk_boxes.push_back(segment.bounding_box);
+    _body_segments.push_back(std::move(segment));
+  }
+}
+
+void Viper::pop_body_segment(bool front) {
+  int64_t index;
+  if (front) {
+    index = _body_segments.front().index;
+    // The next segment starts at the last node of the removed one
+    if (_body_segments.size() > 1)
+      _ring_vertex_begin +=
+        2 * (_viper_configuration->body_node_tables[_detail_level].size() - 1);
+    _body_segments.pop_front();
+  } else {
+    index = _body_segments.back().index;
+    _body_segments.pop_back();
+  }
+  if (_body_segments.empty()) {
+    _ring_chunk_boxes.clear();
+    return;
+  }
+  int64_t next =
+    front ? _body_segments.front().index : _body_segments.back().index;
+  if (ring_chunk(next) == ring_chunk(index))
+    update_ring_chunk_bounding_box(front);
+  else if (front)
+    _ring_chunk_boxes.pop_front();
+  else
+    _ring_chunk_boxes.pop_back();
+}
+
+// Recomputes the box of the newest or the oldest chunk of the ring
+void Viper::update_ring_chunk_bounding_box(bool front) {
+  auto chunk_box = [](auto segment, auto end) {
+    auto chunk = ring_chunk(segment->index);
+    BoundingBox box = segment->bounding_box;
+    for (++segment; segment != end && ring_chunk(segment->index) == chunk;
+         ++segment)
+      box.include(segment->bounding_box);
+    return box;
+  };
+  if (front)
+    _ring_chunk_boxes.front() =
+      chunk_box(_body_segments.cbegin(), _body_segments.cend());
+  else
+    _ring_chunk_boxes.back() =
+      chunk_box(_body_segments.crbegin(), _body_segments.crend());
+}
+
+/* Makes room for count vertices in front of the ring. The ring moves back by
+ * as many vertices as it has, so it only moves now and then as it grows
+ * forwards, and the strip never holds more than a few rings' worth. */
+void Viper::reserve_front_vertices(size_t count) {
+  if (_ring_vertex_begin >= count)
+    return;
+  size_t ring_count = ring_vertex_count();
+  size_t ring_begin = count + ring_count;
+  auto& vertices = _triangle_strip_body.vertices;
+  vertices.resize(ring_begin + ring_count);
+  auto ring = vertices.begin() + _ring_vertex_begin;
+  std::copy_backward(ring, ring + ring_count,
+                     vertices.begin() + ring_begin + ring_count);
+  _ring_vertex_begin = ring_begin;
+}
+
+size_t Viper::ring_vertex_count() const {
+  if (_body_segments.empty())
+    return 0;
+  size_t nodes = _viper_configuration->body_node_tables[_detail_level].size();
+  return 2 * nodes + (_body_segments.size() - 1) * 2 * (nodes - 1);
+}
+
+/* Samples a body segment that does not fill its place on the grid, adds its
+ * span and polygon, and leaves its vertices in _segment_strip. */
+void Viper::add_partial_body_segment(double texture_index,
+                                     const Time& segment_start,
+                                     const Time& segment_duration) {
+  sample_body_segment(texture_index, segment_start, segment_duration);
+  add_segment_span(_viper_configuration->body_node_tables[_detail_level],
+                   segment_start, segment_duration);
+  if (!_viper_configuration->capsule_collision) {
+    _segment_strip.polygon_corners(_corners, 0, 1);
+    next_polygon().set_corners(_corners);
+  }
+}
+
+void Viper::add_segment_span(const ViperConfiguration::NodeTable& nodes,
+                             const Time& segment_start,
+                             const Time& segment_duration) {
+  _segment_spans.push_back({segment_start, segment_duration, &nodes});
+}
+
+/* Every segment becomes a capsule along the chord of the track, as wide as
+ * the widest node. The ends are pulled in where the nodes there are narrower,
+ * so the round ends do not reach past the tip of the head or the tail. */
+Capsule Viper::create_capsule(const SegmentSpan& span) const {
+  const auto& nodes = *span.nodes;
+  auto half_width = [&](size_t node) {
+    Time time = span.start - span.duration * nodes.time_fraction[node];
+    return std::abs(nodes.width_factor[node]) / _track->velocity(time).abs();
+  };
+  double radius = 0;
+  for (size_t node = 0; node < nodes.size(); ++node)
+    radius = std::max(radius, half_width(node));
+  Vec2 front = _track->position(span.start);
+  Vec2 back = _track->position(span.start - span.duration);
+  double length = distance(front, back);
+  double front_inset = radius - half_width(0);
+  double back_inset = radius - half_width(nodes.size() - 1);
+  if (front_inset + back_inset > length) {
+    double scale = length / (front_inset + back_inset);
+    front_inset *= scale;
+    back_inset *= scale;
+  }
+  if (length > 0) {
+    Vec2 direction = (back - front) / length;
+    front = front + direction * front_inset;
+    back = back - direction * back_inset;
+  }
+  return Capsule(front, back, radius);
+}
+
+void Viper::update_capsules() {
+  PROFILE_FUNCTION();
+  for (size_t index = 0; index < _segment_spans.size(); ++index) {
+    auto capsule = create_capsule(_segment_spans[index]);
+    if (index == _capsules.size())
+      _capsules.push_back(std::make_shared<Capsule>(capsule));
+    else
+      _capsules[index]->set(capsule.start(), capsule.end(), capsule.radius());
+  }
+}
+
+// Hands out the polygons in order, reusing those from the previous update
+Polygon& Viper::next_polygon() {
+  if (_number_of_polygons == _polygons.size())
+    _polygons.push_back(std::make_shared<Polygon>(std::vector<Vec2>()));
+  return *_polygons[_number_of_polygons++];
+}
+
+/* The body consists of whole segments fixed to the track, which are cached in
+ * a ring, and the two partial segments connecting them to the head and the
+ * tail, which are sampled every update. The partial segments use the full node
+ * table squeezed into their duration, so new segments grow out from behind the
+ * head and old ones shrink into the tail. The vertices of the ring stay in
+ * the body strip between the partial segments, and its shapes and chunk boxes
+ * stay with it, so an update only touches the segments that enter or leave
+ * the ring and the two partial ones, whatever the length of the viper. */
+void Viper::create_vertex_vectors_and_polygons_for_body_incrementally(
+  const Time& body_start, const Time& body_duration) {
+  if (_mesh_outdated || body_duration <= time_from_seconds(0)) {
+    _body_segments.clear();
+    _ring_chunk_boxes.clear();
+    _triangle_strip_body.vertices.clear();
+    _ring_vertex_begin = 0;
+  }
+  if (body_duration <= time_from_seconds(0))
+    return;
+
+  const Time& grid = _viper_configuration->body_duration;
+  Time tail_start = body_start - body_duration;
+  int64_t newest = std::floor(body_start / grid) - 1;
+  int64_t oldest = std::ceil(tail_start / grid);
+
+  while (!_body_segments.empty() && _body_segments.front().index > newest)
+    pop_body_segment(true);
+  while (!_body_segments.empty() && _body_segments.back().index < oldest)
+    pop_body_segment(false);
+  if (_body_segments.empty()) {
+    for (auto index = newest; index >= oldest; --index)
+      push_body_segment(index, false);
+  } else {
+    for (auto index = _body_segments.front().index + 1; index <= newest;
+         ++index)
+      push_body_segment(index, true);
+    for (auto index = _body_segments.back().index - 1; index >= oldest;
+         --index)
+      push_body_segment(index, false);
+  }
+
+  auto& vertices = _triangle_strip_body.vertices;
+  const auto& segment_vertices = _segment_strip.vertices;
+  Time newest_grid_time = (newest + 1) * grid;
+  Time oldest_grid_time = oldest * grid;
+  Time head_side_end = std::max(tail_start, newest_grid_time);
+  _body_vertex_begin = _ring_vertex_begin;
+  if (body_start > head_side_end) {
+    add_partial_body_segment(-(newest + 1), body_start,
+                             body_start - head_side_end);
+    // The last node is left out if the ring starts with it
+    size_t shared = _body_segments.empty() ? 0 : 2;
+    size_t count = segment_vertices.size() - shared;
+    reserve_front_vertices(count);
+    if (vertices.size() < _ring_vertex_begin)
+      vertices.resize(_ring_vertex_begin);
+    _body_vertex_begin = _ring_vertex_begin - count;
+    std::copy(segment_vertices.cbegin(), segment_vertices.cbegin() + count,
+              vertices.begin() + _body_vertex_begin);
+    _body_vertex_ends.push_back(_ring_vertex_begin + shared);
+    _front_body_segments = 1;
+  }
+  _ring_position = _segment_spans.size();
+  // Only if the body crosses the grid at all
+  if (oldest_grid_time <= newest_grid_time && oldest_grid_time > tail_start) {
+    add_partial_body_segment(-(oldest - 1), oldest_grid_time,
+                             oldest_grid_time - tail_start);
+    // The first node is left out if the body before ends with it
+    size_t shared =
+      _front_body_segments + _body_segments.size() == 0 ? 0 : 2;
+    size_t count = segment_vertices.size() - shared;
+    size_t ring_end = _ring_vertex_begin + ring_vertex_count();
+    if (vertices.size() < ring_end + count)
+      vertices.resize(ring_end + count);
+    std::copy(segment_vertices.cbegin() + shared, segment_vertices.cend(),
+              vertices.begin() + ring_end);
+    _body_vertex_ends.push_back(ring_end + count);
   }
-  std::ranges::for_each(
-    vertex_vector->create_polygons(number_of_segments), [this](auto& polygon) {
-      _polygons.push_back(std::make_shared<Polygon>(std::move(polygon)));
-    });
 }
 
 void Viper::update_vertices_and_polygons() {
+  PROFILE_ZONE("Viper mesh");
   Time head_duration =
     std::min(_temporal_length, _viper_configuration->head_duration);
   if (_temporal_length < _viper_configuration->head_duration +
@@ -276,44 +773,96 @@ void Viper::update_vertices_and_polygons() {
   Time body_start = head_start - head_duration;
   Time tail_start = body_start - body_duration;
 
-  _polygons.clear();
+  // Keeps the polygons and the storage of the vertices for reuse
+  _number_of_polygons = 0;
+  // The vertices are created from the head backwards in time
+  _dinner_cursor = _dinner_times.size();
   _triangle_strip_head.vertices.clear();
-  _triangle_strip_body.vertices.clear();
+  // The incremental mesh keeps its cached segments in the body strip
+  if (!_viper_configuration->incremental_mesh)
+    _triangle_strip_body.vertices.clear();
   _triangle_strip_tail.vertices.clear();
+  _body_vertex_ends.clear();
+  _segment_spans.clear();
   create_vertex_vectors_and_polygons_for_body_part(ViperPart::Head, head_start,
                                                    head_duration);
-  create_vertex_vectors_and_polygons_for_body_part(ViperPart::Body, body_start,
-                                                   body_duration);
+  _first_body_segment = _segment_spans.size();
+  _ring_position = _segment_spans.size();
+  _front_body_segments = 0;
+  _body_vertex_begin = 0;
+  if (_viper_configuration->incremental_mesh) {
+    create_vertex_vectors_and_polygons_for_body_incrementally(body_start,
+                                                              body_duration);
+  } else {
+    create_vertex_vectors_and_polygons_for_body_part(ViperPart::Body,
+                                                     body_start, body_duration);
+    _front_body_segments = _body_vertex_ends.size();
+  }
   create_vertex_vectors_and_polygons_for_body_part(ViperPart::Tail, tail_start,
                                                    tail_duration);
+  if (_viper_configuration->capsule_collision)
+    update_capsules();
+  update_chunk_bounding_boxes();
+  _mesh_outdated = false;
 }
 
-sf::Color Viper::calculate_vertex_color(Time time) {
-  // TODO: Loop through DinnerTimes instead of calling for every vertex.
+/* Only the chunks of the segments sampled this update, as the ring keeps the
+ * boxes of its own chunks. Without a ring all segments are chunked from the
+ * head. */
+void Viper::update_chunk_bounding_boxes() {
+  // The vector keeps its storage between updates
+  _chunk_bounding_boxes.clear();
+  auto add_chunks = [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      auto box = segment_shape(index)->bounding_box();
+      if ((index - begin) % segments_per_chunk == 0)
+        _chunk_bounding_boxes.push_back(box);
+      else
+        _chunk_bounding_boxes.back().include(box);
+    }
+  };
+  if (_body_segments.empty()) {
+    add_chunks(0, number_of_segments());
+    _chunks_before_ring = _chunk_bounding_boxes.size();
+  } else {
+    add_chunks(0, _ring_position);
+    _chunks_before_ring = _chunk_bounding_boxes.size();
+    add_chunks(_ring_position + _body_segments.size(), number_of_segments());
+  }
+}
 
-  auto headSide = _dinner_times.lower_bound(time);  // Closer to head
+sf::Color Viper::calculate_vertex_color(Time time) {
+  /* Moves the cursor to the first dinner at or after time. The vertices are
+   * mostly created in time order, so the cursor only moves a step now and
+   * then, but it can walk in both directions. */
+  while (_dinner_cursor > 0 && _dinner_times[_dinner_cursor - 1].time >= time)
+    --_dinner_cursor;
+  while (_dinner_cursor < _dinner_times.size() &&
+         _dinner_times[_dinner_cursor].time < time)
+    ++_dinner_cursor;
+  auto headSide = _dinner_times.cbegin() + _dinner_cursor;  // Closer to head
   auto tailSide = headSide != _dinner_times.cbegin() ? std::prev(headSide)
                                                      : _dinner_times.cend();
 
   double sFactor1 = 0;
   sf::Color color1 = sf::Color::Transparent;
   if (tailSide != _dinner_times.end()) {
-    Time half_length = tailSide->second.amount;
-    Time mid_point = tailSide->first + 0.5 * half_length;
+    Time half_length = tailSide->amount;
+    Time mid_point = tailSide->time + 0.5 * half_length;
     Time distance = std::chrono::abs(time - mid_point);
     if (distance < 0.5 * half_length) {
-      color1 = tailSide->second.color;
+      color1 = tailSide->color;
       sFactor1 = 1. - distance / half_length;
     }
   }
   double sFactor2 = 0;
   sf::Color color2 = sf::Color::Transparent;
   if (headSide != _dinner_times.end()) {
-    Time half_length = headSide->second.amount;
-    Time mid_point = headSide->first + 0.5 * half_length;
+    Time half_length = headSide->amount;
+    Time mid_point = headSide->time + 0.5 * half_length;
     Time distance = std::chrono::abs(time - mid_point);
     if (distance < 0.5 * half_length) {
-      color1 = headSide->second.color;
+      color1 = headSide->color;
       sFactor1 = 1. - distance / half_length;
     }
   }
@@ -4,6 +4,10 @@
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Vertex.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <vvipers/Collisions/CollidingBody.hpp>
@@ -16,8 +20,16 @@
 #include <vvipers/GameElements/ViperConfiguration.hpp>
 #include <vvipers/Utilities/Time.hpp>
 #include <vvipers/Utilities/TriangleStripArray.hpp>
+#include <vvipers/config.hpp>
 
 namespace VVipers {
+
+#ifdef COMPACT_TRACK
+typedef CompactTemporalTrack ViperTrack;
+#else
+typedef TemporalTrack ViperTrack;
+#endif
+
 /**
  * A physical model of a Viper (position, speed etc.).
  * Handles all aspects of the Viper that is not related to the graphical
@@ -30,10 +42,18 @@ class Viper : public GameObject,
   public:
     Viper(std::shared_ptr<const ViperConfiguration>, const Vec2& tail_position,
           double angle, double number_of_body_segments);
-    size_t number_of_segments() const override { return _polygons.size(); }
-    std::shared_ptr<const Shape> segment_shape(size_t index) const override {
-        return _polygons[index];
+    size_t number_of_segments() const override {
+        return _segment_spans.size() + _body_segments.size();
     }
+    std::shared_ptr<const Shape> segment_shape(size_t index) const override;
+    /** Long vipers are split into chunks of this many segments, each with a
+     * cached bounding box used for culling and collision rejection. **/
+    static const size_t segments_per_chunk = 16;
+    size_t number_of_chunks() const override {
+        return _chunk_bounding_boxes.size() + _ring_chunk_boxes.size();
+    }
+    std::pair<size_t, size_t> chunk_segments(size_t chunk) const override;
+    BoundingBox chunk_bounding_box(size_t chunk) const override;
     /** Adds time the Viper should spend growing and where along the viper that
      * growth is. **/
     void add_growth(Time howMuch, Time when, sf::Color color);
@@ -55,14 +75,21 @@ class Viper : public GameObject,
     void set_colors(sf::Color primary_color, sf::Color secondary_color) {
         _primaryColor = primary_color;
         _secondaryColor = secondary_color;
+        _mesh_outdated = true;
     }
     /** Consumes food that will add both growth and some boost charge **/
     void eat(const Food& food);
     /** Changes state to Dying and will eventually become Dead **/
     void die(const Time& elapsedTime);
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    /** Calls strip_range with the vertex ranges of the head, the body chunks
+     * overlapping view_box and the tail, in drawing order. **/
+    void visible_strips(
+        const BoundingBox& view_box,
+        const std::function<void(const TriangleStripArray&, size_t, size_t)>&
+            strip_range) const;
     /** @returns The track the viper follows. **/
-    const TemporalTrack& temporal_track() const { return *_track; }
+    const ViperTrack& temporal_track() const { return *_track; }
     /** @returns the spatial length of the Viper. **/
     double length() const;
     void set_speed(double s) { _speed = s; }
@@ -82,11 +109,30 @@ class Viper : public GameObject,
      * member function. **/
     void update(Time elapsedTime);
     Vec2 velocity() const { return Vec2(_speed, 0).rotate(_angle); }
+    /** @returns the path the tip of the head took during the last update,
+     * as wide as the tip. Lets fast vipers hit thin walls they would
+     * otherwise have passed through between two updates. **/
+    Capsule swept_head() const;
+    /** @returns how far to move the viper to draw it between its last two
+     * states, 0 being the previous and 1 the latest. The whole viper moves
+     * like its head, which is exact while it goes straight. **/
+    Vec2 interpolation_offset(double interpolation) const {
+        return (interpolation - 1) *
+               (_track->head_position() - _previous_head_position);
+    }
     const ViperConfiguration& viper_configuration() const {
         return *_viper_configuration.get();
     }
+    /** Selects one of the node tables of the ViperConfiguration, 0 being the
+     * most detailed. **/
+    void set_detail_level(size_t level);
+    size_t detail_level() const { return _detail_level; }
+    /** @returns the approximate number of vertices at the detail level **/
+    size_t estimated_vertex_count(size_t level) const;
 
   private:
+    // Lets the tests reach calculate_vertex_color and the body strip
+    friend struct ViperTestAccess;
     std::shared_ptr<const ViperConfiguration> _viper_configuration;
 
     enum class ViperPart { Head, Body, Tail };
@@ -98,6 +144,36 @@ class Viper : public GameObject,
     void update_vertices_and_polygons();
     void create_vertex_vectors_and_polygons_for_body_part(
         ViperPart, const Time& timeFront, const Time& temporalLength);
+    void create_vertex_vectors_and_polygons_for_body_incrementally(
+        const Time& body_start, const Time& body_duration);
+    void append_segment_vertices(std::vector<sf::Vertex>& vertices,
+                                 const ViperConfiguration::NodeTable& nodes,
+                                 double texture_index,
+                                 const Time& segment_start,
+                                 const Time& segment_duration,
+                                 size_t first_node);
+    template <typename NodeCount>
+    void append_nodes(std::vector<sf::Vertex>& vertices,
+                      const ViperConfiguration::NodeTable& nodes,
+                      NodeCount number_of_nodes, double texture_index,
+                      const Time& segment_start, const Time& segment_duration,
+                      size_t first_node);
+    void sample_body_segment(double texture_index, const Time& segment_start,
+                             const Time& segment_duration);
+    void add_partial_body_segment(double texture_index,
+                                  const Time& segment_start,
+                                  const Time& segment_duration);
+    void add_segment_span(const ViperConfiguration::NodeTable& nodes,
+                          const Time& segment_start,
+                          const Time& segment_duration);
+    void update_capsules();
+    void update_chunk_bounding_boxes();
+    Polygon& next_polygon();
+    size_t body_vertex_begin(size_t body_segment) const;
+    size_t body_vertex_end(size_t body_segment) const;
+    /** @returns the color of the body at a time along the track. The search
+     * for the dinners nearby continues from the previous call, so calls with
+     * times close to each other are cheap. **/
     sf::Color calculate_vertex_color(Time time);
 
     void update_motion(const Time& elapsedTime);
@@ -115,20 +191,79 @@ class Viper : public GameObject,
     Time _boost_recharge_cooldown;  // Countdown from viperBoostChargeCooldown
     Time _temporal_length;          // s
     Time _growth;                   // s
-    std::unique_ptr<TemporalTrack> _track;
+    Vec2 _previous_head_position;   // Before the last update
+    std::unique_ptr<ViperTrack> _track;
     sf::Color _primaryColor;
     sf::Color _secondaryColor;
     struct Dinner {
+        Time time;
         Time amount;
         sf::Color color;
     };
-    std::map<Time, Dinner> _dinner_times;
+    // Sorted by time. There are never more than a handful of dinners.
+    std::vector<Dinner> _dinner_times;
+    size_t _dinner_cursor;  // Used by calculate_vertex_color
 
     TriangleStripArray _triangle_strip_head;
     TriangleStripArray _triangle_strip_body;
     TriangleStripArray _triangle_strip_tail;
 
+    // Only the first _number_of_polygons are in use, the rest are kept so
+    // that they can be rewritten instead of reallocated
     std::vector<std::shared_ptr<Polygon>> _polygons;
+    size_t _number_of_polygons;
+    std::vector<Vec2> _corners;  // Scratch space for polygon corners
+    // Where along the track each segment lies, in the same order as the
+    // polygons
+    struct SegmentSpan {
+        Time start;
+        Time duration;
+        const ViperConfiguration::NodeTable* nodes;
+    };
+    std::vector<SegmentSpan> _segment_spans;
+    Capsule create_capsule(const SegmentSpan& span) const;
+    // Used instead of the polygons if the configuration says so. Like the
+    // polygons they are rewritten instead of reallocated.
+    std::vector<std::shared_ptr<Capsule>> _capsules;
+    /* The segments are numbered from the head. The head, the body segments
+     * sampled this update and the tail have a polygon or capsule and a span
+     * above, but the cached body segments, from _ring_position on, keep their
+     * own. The chunks of the sampled segments before the ring come first,
+     * then the chunks of the ring, then those of the segments after it. */
+    size_t _first_body_segment;
+    size_t _ring_position;
+    std::vector<BoundingBox> _chunk_bounding_boxes;
+    size_t _chunks_before_ring;
+    /* The body strip holds the sampled segments before the ring, the ring and
+     * the sampled segments after it. Each body segment shares its first two
+     * vertices with the previous one. */
+    size_t _front_body_segments;
+    size_t _body_vertex_begin;
+    std::vector<size_t> _body_vertex_ends;  // Of the sampled segments
+
+    /* Used by the incremental mesh. Whole body segments lie on a grid of body
+     * durations along the track, so once created their geometry never changes
+     * until the colors or the dinners do. Their vertices stay in the body
+     * strip, which has room in front of them for the segments to come. */
+    struct BodySegment {
+        int64_t index;  // Spans [index, index + 1] body durations
+        std::shared_ptr<const Shape> shape;
+        BoundingBox bounding_box;
+    };
+    BodySegment create_body_segment(int64_t index);
+    // Adds or removes the newest segment if front is true, else the oldest
+    void push_body_segment(int64_t index, bool front);
+    void pop_body_segment(bool front);
+    void update_ring_chunk_bounding_box(bool front);
+    void reserve_front_vertices(size_t count);
+    size_t ring_vertex_count() const;
+    std::deque<BodySegment> _body_segments;  // The ring, newest first
+    // The chunks of the ring lie on a grid of segments_per_chunk segments
+    std::deque<BoundingBox> _ring_chunk_boxes;  // Newest first
+    size_t _ring_vertex_begin;
+    TriangleStripArray _segment_strip;  // Scratch space for one segment
+    bool _mesh_outdated;
+    size_t _detail_level;
 };
 
 }  // namespace VVipers
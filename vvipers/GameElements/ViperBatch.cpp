@@ -0,0 +1,66 @@
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <vvipers/GameElements/ViperBatch.hpp>
+
+namespace VVipers {
+
+void ViperBatch::pack(const std::vector<const Viper*>& vipers,
+                      const BoundingBox& view_box, double interpolation) {
+    for (auto& batch : _batches) {
+        batch.vertices.clear();
+        batch.uploaded = false;
+    }
+    for (auto viper : vipers) {
+        sf::Vector2f offset(viper->interpolation_offset(interpolation));
+        viper->visible_strips(view_box, [&](const TriangleStripArray& strip,
+                                            size_t begin, size_t end) {
+            if (end <= begin)
+                return;
+            auto& vertices = batch_for(strip.texture).vertices;
+            // Repeating the last vertex and the next first vertex creates
+            // degenerate triangles that connect the strips without drawing
+            if (!vertices.empty()) {
+                vertices.push_back(vertices.back());
+                vertices.push_back(strip.vertices[begin]);
+                vertices.back().position += offset;
+            }
+            size_t first = vertices.size();
+            vertices.insert(vertices.end(), strip.vertices.cbegin() + begin,
+                            strip.vertices.cbegin() + end);
+            if (offset != sf::Vector2f())
+                for (size_t i = first; i < vertices.size(); ++i)
+                    vertices[i].position += offset;
+        });
+    }
+}
+
+ViperBatch::Batch& ViperBatch::batch_for(const sf::Texture* texture) {
+    for (auto& batch : _batches)
+        if (batch.texture == texture)
+            return batch;
+    auto& batch = _batches.emplace_back();
+    batch.texture = texture;
+    return batch;
+}
+
+void ViperBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    for (const auto& batch : _batches) {
+        if (batch.vertices.empty())
+            continue;
+        states.texture = batch.texture;
+        if (!sf::VertexBuffer::isAvailable()) {
+            target.draw(batch.vertices.data(), batch.vertices.size(),
+                        sf::PrimitiveType::TriangleStrip, states);
+            continue;
+        }
+        if (!batch.uploaded) {
+            if (batch.buffer.getVertexCount() < batch.vertices.size())
+                batch.buffer.create(2 * batch.vertices.size());
+            batch.buffer.update(batch.vertices.data(), batch.vertices.size(),
+                                0);
+            batch.uploaded = true;
+        }
+        target.draw(batch.buffer, 0, batch.vertices.size(), states);
+    }
+}
+
+}  // namespace VVipers
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <vector>
+#include <vvipers/GameElements/Viper.hpp>
+#include <vvipers/Utilities/Shape.hpp>
+
+namespace VVipers {
+
+/** Packs the triangle strips of many vipers into one strip per texture, joined
+ * by degenerate triangles, so that all vipers are drawn with one draw call per
+ * texture. **/
+class ViperBatch : public sf::Drawable {
+  public:
+    /** Replaces the contents with the parts of the vipers inside view_box,
+     * placed between their last two states according to interpolation **/
+    void pack(const std::vector<const Viper*>& vipers,
+              const BoundingBox& view_box, double interpolation = 1);
+    size_t number_of_batches() const { return _batches.size(); }
+    const sf::Texture* batch_texture(size_t index) const {
+        return _batches[index].texture;
+    }
+    const std::vector<sf::Vertex>& batch_vertices(size_t index) const {
+        return _batches[index].vertices;
+    }
+    /** Streams the packed vertices to the graphics card if vertex buffers are
+     * available, otherwise they are drawn from memory. **/
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+  private:
+    struct Batch {
+        const sf::Texture* texture = nullptr;
+        std::vector<sf::Vertex> vertices;
+        // Uploaded when drawn, only grows
+        mutable sf::VertexBuffer buffer{sf::PrimitiveType::TriangleStrip,
+                                        sf::VertexBuffer::Stream};
+        mutable bool uploaded = false;
+    };
+    Batch& batch_for(const sf::Texture* texture);
+    // Batches are kept between packs so that their storage can be reused
+    std::vector<Batch> _batches;
+};
+
+}  // namespace VVipers
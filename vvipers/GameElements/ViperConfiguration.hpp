@@ -1,5 +1,11 @@
 #pragma once
 
+#include <SFML/Graphics/Texture.hpp>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "vvipers/Engine/Providers.hpp"
 #include "vvipers/Utilities/Time.hpp"
 
@@ -19,6 +25,14 @@ class ViperConfiguration {
             options.option_double("Viper/boostRechargeRate");  // s per s
         boost_recharge_cooldown = time_from_seconds(options.option_double(
             "Viper/boostRechargeCooldown"));  // Countdown start
+        incremental_mesh = options.is_option_set("Viper/incrementalMesh") &&
+                           options.option_boolean("Viper/incrementalMesh");
+        capsule_collision =
+            options.is_option_set("Viper/capsuleCollision") &&
+            options.option_boolean("Viper/capsuleCollision");
+        vertex_budget = options.is_option_set("Viper/vertexBudget")
+                            ? options.option_int("Viper/vertexBudget")
+                            : 0;
 
         head_nominal_length =
             options.option_double("ViperModel/ViperHead/nominalLength");  // px
@@ -41,31 +55,131 @@ class ViperConfiguration {
         tail_nodes =
             options.option_2d_vector_array("ViperModel/ViperTail/nodes");
 
+        for (size_t level = 0; level < number_of_detail_levels; ++level) {
+            // Halve the number of nodes for every level
+            size_t divisor = size_t(1) << level;
+            head_node_levels[level] = reduce_nodes(
+                head_nodes, (head_nodes.size() + divisor - 1) / divisor);
+            body_node_levels[level] = reduce_nodes(
+                body_nodes, (body_nodes.size() + divisor - 1) / divisor);
+            tail_node_levels[level] = reduce_nodes(
+                tail_nodes, (tail_nodes.size() + divisor - 1) / divisor);
+        }
+
         head_texture = textures.texture("ViperHead");
         body_texture = textures.texture("ViperBody");
         tail_texture = textures.texture("ViperTail");
+        head_texture_rect = textures.texture_rect("ViperHead");
+        body_texture_rect = textures.texture_rect("ViperBody");
+        tail_texture_rect = textures.texture_rect("ViperTail");
+
+        for (size_t level = 0; level < number_of_detail_levels; ++level) {
+            head_node_tables[level] =
+                create_node_table(head_node_levels[level], head_texture_rect);
+            body_node_tables[level] =
+                create_node_table(body_node_levels[level], body_texture_rect);
+            tail_node_tables[level] =
+                create_node_table(tail_node_levels[level], tail_texture_rect);
+        }
     }
 
+    /** Everything the mesh generation needs to know about the nodes of a
+     * segment, computed once and stored contiguously per quantity. **/
+    struct NodeTable {
+        std::vector<double> time_fraction;  // 0 at the front of the segment
+        // Nominal speed times the width, divided by the speed squared gives
+        // the half width of the viper at the node
+        std::vector<double> width_factor;
+        std::vector<float> texture_u_right;
+        std::vector<float> texture_u_left;
+        std::vector<float> texture_v;  // Within the first segment
+        float texture_height;          // Texture offset for every segment
+        size_t size() const { return time_fraction.size(); }
+    };
+
+    /** The texture coordinates are placed within area, the part of the
+     * texture belonging to the nodes. **/
+    NodeTable create_node_table(const std::vector<Vec2>& nodes,
+                                const sf::IntRect& area) const {
+        NodeTable table;
+        table.texture_height = area.height;
+        for (const auto& node : nodes) {
+            table.time_fraction.push_back(node.y);
+            table.width_factor.push_back(nominal_speed *
+                                         nominal_segment_width * node.x);
+            table.texture_u_right.push_back(area.left +
+                                            (0.5 + node.x) * area.width);
+            table.texture_u_left.push_back(area.left +
+                                           (0.5 - node.x) * area.width);
+            table.texture_v.push_back(area.top + node.y * area.height);
+        }
+        return table;
+    }
+
+    /** Removes the nodes that contribute the least to the silhouette until
+     * number_of_nodes remain, but never fewer than three. The first and last
+     * nodes are always kept since they are shared with the neighbouring
+     * segments. **/
+    static std::vector<Vec2> reduce_nodes(std::vector<Vec2> nodes,
+                                          size_t number_of_nodes) {
+        number_of_nodes = std::max(number_of_nodes, size_t(3));
+        while (nodes.size() > number_of_nodes) {
+            // The area of the triangle formed with the neighbours measures
+            // how much the outline changes if the node is removed
+            size_t least_significant = 1;
+            double least_area = std::numeric_limits<double>::max();
+            for (size_t i = 1; i + 1 < nodes.size(); ++i) {
+                double area = std::abs((nodes[i] - nodes[i - 1])
+                                           .perpendicular()
+                                           .dot(nodes[i + 1] - nodes[i - 1]));
+                if (area < least_area) {
+                    least_area = area;
+                    least_significant = i;
+                }
+            }
+            nodes.erase(nodes.begin() + least_significant);
+        }
+        return nodes;
+    }
+
+    static const size_t number_of_detail_levels = 3;
+
     double nominal_speed;          // px/s
     double nominal_segment_width;  // px
     Time boost_max_charge;         // s
     double boost_recharge_rate;    // s per s
     Time boost_recharge_cooldown;  // Countdown start
+    // Anchor body segments to the track and only update the ends of the body
+    bool incremental_mesh;
+    // Collide with a chain of capsules along the track instead of polygons
+    bool capsule_collision;
+    // Total number of vertices for all vipers before their level of detail is
+    // lowered, 0 means no limit
+    int vertex_budget;
 
     double head_nominal_length;  // px
     Time head_duration;          // s
     std::vector<Vec2> head_nodes;
+    std::array<std::vector<Vec2>, number_of_detail_levels> head_node_levels;
+    std::array<NodeTable, number_of_detail_levels> head_node_tables;
     const sf::Texture* head_texture;
+    sf::IntRect head_texture_rect;
 
     double body_nominal_length;  // px
     Time body_duration;          // s
     std::vector<Vec2> body_nodes;
+    std::array<std::vector<Vec2>, number_of_detail_levels> body_node_levels;
+    std::array<NodeTable, number_of_detail_levels> body_node_tables;
     const sf::Texture* body_texture;
+    sf::IntRect body_texture_rect;
 
     double tail_nominal_length;  // px
     Time tail_duration;          // s
     std::vector<Vec2> tail_nodes;
+    std::array<std::vector<Vec2>, number_of_detail_levels> tail_node_levels;
+    std::array<NodeTable, number_of_detail_levels> tail_node_tables;
     const sf::Texture* tail_texture;
+    sf::IntRect tail_texture_rect;
 };
 
 }
\ No newline at end of file
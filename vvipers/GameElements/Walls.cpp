@@ -4,6 +4,7 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <vvipers/GameElements/Walls.hpp>
@@ -16,8 +17,10 @@
 
 namespace VVipers {
 
-Walls::Walls(Vec2 levelSize) : CollidingBody("Walls"), _level_size(levelSize) {
+Walls::Walls(Vec2 levelSize, bool with_graphics)
+    : CollidingBody("Walls"), _level_size(levelSize) {
     constructLevel();
+    upload_static_geometry(with_graphics);
 }
 
 std::shared_ptr<const Shape> Walls::segment_shape(size_t index) const {
@@ -71,9 +74,37 @@ void Walls::constructLevel() {
     }
 }
 
+void Walls::upload_static_geometry(bool allow_buffer) {
+    _static_ranges.clear();
+    _static_vertices.clear();
+    // Pieces sharing a texture are drawn together however many they are
+    std::vector<const sf::Texture*> textures;
+    for (const auto& strip : _triangle_strips)
+        if (std::ranges::find(textures, strip.texture) == textures.end())
+            textures.push_back(strip.texture);
+    for (auto texture : textures) {
+        size_t first = _static_vertices.size();
+        for (const auto& strip : _triangle_strips)
+            if (strip.texture == texture)
+                strip.append_triangles(_static_vertices);
+        _static_ranges.push_back(
+            {texture, first, _static_vertices.size() - first});
+    }
+    // Without vertex buffers the vertices are drawn from memory instead
+    _use_static_buffer = allow_buffer && sf::VertexBuffer::isAvailable() &&
+                         _static_buffer.create(_static_vertices.size()) &&
+                         _static_buffer.update(_static_vertices.data());
+}
+
 void Walls::draw(sf::RenderTarget& target, sf::RenderStates states) const {
-    for (auto& strip : _triangle_strips)
-        strip.draw(target, states);
+    for (const auto& range : _static_ranges) {
+        states.texture = range.texture;
+        if (_use_static_buffer)
+            target.draw(_static_buffer, range.first, range.count, states);
+        else
+            target.draw(&_static_vertices[range.first], range.count,
+                        sf::PrimitiveType::Triangles, states);
+    }
 }
 
 }  // namespace VVipers
\ No newline at end of file
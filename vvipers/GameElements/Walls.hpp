@@ -3,6 +3,7 @@
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 #include <memory>
 #include <vvipers/GameElements/GameObject.hpp>
 
@@ -14,17 +15,42 @@ namespace VVipers {
 
 class Walls : public GameObject, public sf::Drawable, public CollidingBody {
   public:
-    Walls(Vec2 levelSize);
+    /** Without graphics the walls are drawn from memory, which needs no
+     * graphics context to set up. **/
+    Walls(Vec2 levelSize, bool with_graphics = true);
     size_t number_of_segments() const override { return _polygons.size(); }
     std::shared_ptr<const Shape> segment_shape(size_t index) const override;
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
+    /** The strips as triangle lists, with one range per texture. **/
+    struct StaticRange {
+        const sf::Texture* texture;
+        size_t first;
+        size_t count;
+    };
+    const std::vector<StaticRange>& static_ranges() const {
+        return _static_ranges;
+    }
+    const std::vector<sf::Vertex>& static_vertices() const {
+        return _static_vertices;
+    }
+    /** Whether the vertices are drawn from the graphics card or memory. **/
+    bool uses_static_buffer() const { return _use_static_buffer; }
+
   protected:
     virtual void constructLevel();
+    /** Uploads the strips to the graphics card once, unless buffers are not
+     * allowed or available. Must be called again if the strips change. **/
+    void upload_static_geometry(bool allow_buffer = true);
 
   private:
     Vec2 _level_size;
     std::vector<TriangleStripArray> _triangle_strips;
+    std::vector<StaticRange> _static_ranges;
+    std::vector<sf::Vertex> _static_vertices;
+    sf::VertexBuffer _static_buffer{sf::PrimitiveType::Triangles,
+                                    sf::VertexBuffer::Static};
+    bool _use_static_buffer = false;
     std::vector<std::shared_ptr<Polygon>> _polygons;
 };
 
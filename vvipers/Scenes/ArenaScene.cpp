@@ -17,6 +17,7 @@
 #include <typeinfo>
 
 #include "vvipers/Engine/Providers.hpp"
+#include "vvipers/Engine/RenderSnapshot.hpp"
 #include "vvipers/GameElements/GameEvent.hpp"
 #include "vvipers/GameElements/GameObject.hpp"
 #include "vvipers/GameElements/Player.hpp"
@@ -25,6 +26,7 @@
 #include "vvipers/Scenes/GameOverScene.hpp"
 #include "vvipers/Scenes/PauseScene.hpp"
 #include "vvipers/UIElements/PlayerPanel.hpp"
+#include "vvipers/Utilities/Profiler.hpp"
 #include "vvipers/Utilities/Time.hpp"
 #include "vvipers/Utilities/VVColor.hpp"
 #include "vvipers/Utilities/VVMath.hpp"
@@ -57,7 +59,9 @@ ArenaScene::PlayerData ArenaScene::read_player_conf(size_t player) {
 }
 
 ArenaScene::ArenaScene(GameResources& game_resources)
-  : Scene(game_resources), _collision_manager(5, 100.) {
+  : Scene(game_resources),
+    _collision_manager(5, 100.),
+    _hud_numbers(game_resources.font_service().default_font()) {
   size_t number_of_players =
     game_resources.options_service().option_int("Players/numberOfPlayers");
   std::vector<PlayerData> player_data;
@@ -93,13 +97,14 @@ ArenaScene::ArenaScene(GameResources& game_resources)
   _game_view.setViewport(
     sf::FloatRect({0.f, status_bar_relative_size.y}, game_relative_size));
 
-  _walls = std::make_unique<Walls>(game_size);
+  _walls = std::make_unique<Walls>(game_size, !game_resources.is_headless());
   _collision_manager.register_colliding_body(_walls.get());
 
   // The players must absolutely be added _after_ the level has been filled
   // with obstacles, otherwise they might end up inside or on top of them.
   dispense_food();
   add_players(player_data, status_bar_views);
+  pack_render_batches();
 
   // Only create one pause screen so that it can be reused
   _pause_scene = std::make_shared<PauseScene>(game_resources);
@@ -124,7 +129,8 @@ void ArenaScene::add_players(std::vector<PlayerData>& player_data,
         keys.left = sf::Keyboard::Scancode(data.keys[0]);
         keys.right = sf::Keyboard::Scancode(data.keys[1]);
         keys.boost = sf::Keyboard::Scancode(data.keys[2]);
-        controller = std::make_unique<KeyboardController>(keys);
+        controller =
+            std::make_unique<KeyboardController>(game_resources(), keys);
       }
       controller->add_observer(this, {GameEvent::EventType::ObjectModified});
       auto viper = add_viper(viper_configuration, excluded_starting_areas);
@@ -265,6 +271,7 @@ void ArenaScene::find_free_space_for(
 }
 
 void ArenaScene::dispense_food() {
+  PROFILE_FUNCTION();
   while (_food.size() < 2) {
     double smallest = Food::nominal_food_radius * 0.75;
     double largest = Food::nominal_food_radius * 1.25;
@@ -278,6 +285,7 @@ void ArenaScene::dispense_food() {
 }
 
 void ArenaScene::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+  PROFILE_ZONE("Arena draw");
   target.clear(sf::Color::Black);
   for (const auto& panel : _player_panels) {
     target.setView(panel->view());
@@ -285,20 +293,57 @@ void ArenaScene::draw(sf::RenderTarget& target, sf::RenderStates states) const {
   }
   target.setView(_game_view);
   target.draw(*_walls, states);
-  for (const auto& f : _food)
-    target.draw(*f, states);
-  for (const auto& p : _players)
-    target.draw(*p->viper(), states);
+  target.draw(_food_batch, states);
+  target.draw(_viper_batch, states);
   target.setView(target.getDefaultView());
-  for (const auto& s : _flying_scores)
-    target.draw(*s, states);
+  target.draw(_hud_numbers, states);
+}
+
+// Mirrors draw, the walls do not change after construction and are referenced
+bool ArenaScene::take_snapshot(RenderSnapshot& snapshot) const {
+  PROFILE_FUNCTION();
+  for (const auto& panel : _player_panels) {
+    snapshot.set_view(panel->view());
+    panel->take_snapshot(snapshot);
+  }
+  snapshot.set_view(_game_view);
+  snapshot.add_reference(*_walls);
+  const auto& food_vertices = _food_batch.vertices();
+  if (food_vertices.getVertexCount() > 0)
+    snapshot.add_vertices(&food_vertices[0], food_vertices.getVertexCount(),
+                          food_vertices.getPrimitiveType());
+  for (size_t index = 0; index < _viper_batch.number_of_batches(); ++index) {
+    const auto& vertices = _viper_batch.batch_vertices(index);
+    snapshot.add_vertices(vertices.data(), vertices.size(),
+                          sf::PrimitiveType::TriangleStrip,
+                          sf::RenderStates(_viper_batch.batch_texture(index)));
+  }
+  snapshot.set_view(game_resources().window_manager().default_view());
+  const auto& numbers = _hud_numbers.vertices();
+  snapshot.add_vertices(numbers.data(), numbers.size(),
+                        sf::PrimitiveType::Triangles,
+                        sf::RenderStates(_hud_numbers.texture()));
+  return true;
 }
 
 void ArenaScene::handle_collisions() {
+  PROFILE_FUNCTION();
   BoundingBox the_world(_game_view.getCenter(), _game_view.getSize());
   for (auto& collision : _collision_manager.check_for_collisions(the_world)) {
     handle_collision(collision);
   }
+  // The heads may have passed through thin walls or other vipers between two
+  // updates, so their paths are tested as well. The handlers ignore anything
+  // already dealt with above.
+  for (auto& player : _players) {
+    Viper* viper = player->viper();
+    if (!viper || viper->state() != GameObject::Alive)
+      continue;
+    for (const auto& collidee :
+         _collision_manager.find_overlapping(viper->swept_head()))
+      if (collidee.body != viper)
+        handle_collision({{viper, 0}, collidee});
+  }
 }
 
 void ArenaScene::handle_collision(const CollisionPair& collision) {
@@ -347,10 +392,10 @@ void ArenaScene::handle_viper_food_collision(Viper* viper,
     4 * viper->velocity(),
     Vec2(game_resources().window_manager().map_coordinates_to_pixel_values(
       panel->score_target(), panel->view())),
-    1s, score, game_resources().font_service()));
+    1s, score));
   flyingScore->set_color(sf::Color::Magenta, sf::Color::Red);
   flyingScore->set_font_size(
-    0.03 * game_resources().window_manager().window_size().y, 1.0);
+    0.03 * game_resources().window_manager().window_size().y);
   flyingScore->add_observer(this, {GameEvent::EventType::Destroy});
   flyingScore->add_observer(panel, {GameEvent::EventType::Scoring});
 }
@@ -445,8 +490,9 @@ void ArenaScene::check_for_game_over() {
   for (auto& p : _players)
     players.push_back(p.get());
   SceneEvent scene_event(SceneEvent::SceneEventType::Spawn);
-  scene_event.target_scene =
-    make_shared<GameOverScene>(game_resources(), players);
+  scene_event.scene_factory = [&game = game_resources(), players] {
+    return std::make_shared<GameOverScene>(game, players);
+  };
   notify(scene_event);
 }
 
@@ -502,6 +548,7 @@ void ArenaScene::process_deletions() {
 }
 
 void ArenaScene::update(const Time& elapsed_time) {
+  PROFILE_ZONE("Arena update");
   Stopwatch clock;
   clock.start();
   update_objects(elapsed_time);
@@ -512,16 +559,104 @@ void ArenaScene::update(const Time& elapsed_time) {
   check_for_game_over();
 }
 
+void ArenaScene::interpolate(double interpolation) {
+  _interpolation = interpolation;
+  pack_render_batches();
+}
+
+sf::Transform ArenaScene::view_to_window_transform(const sf::View& view) {
+  Vec2 window_size = game_resources().window_manager().window_size();
+  const auto& viewport = view.getViewport();
+  Vec2 view_corner = view.getCenter() - 0.5f * view.getSize();
+  sf::Transform transform;
+  transform.translate(viewport.left * window_size.x,
+                      viewport.top * window_size.y);
+  transform.scale(viewport.width * window_size.x / view.getSize().x,
+                  viewport.height * window_size.y / view.getSize().y);
+  transform.translate(-view_corner.x, -view_corner.y);
+  return transform;
+}
+
+// Done once per drawn frame, however many updates there were
+void ArenaScene::pack_render_batches() {
+  PROFILE_FUNCTION();
+  std::vector<const Food*> food;
+  for (auto& item : _food)
+    food.push_back(item.get());
+  _food_batch.pack(food, _interpolation);
+
+  // All numbers are written in window coordinates
+  _hud_numbers.clear();
+  for (const auto& panel : _player_panels)
+    panel->write_numbers(_hud_numbers, view_to_window_transform(panel->view()));
+  for (const auto& flying_score : _flying_scores)
+    flying_score->write_text(_hud_numbers, _interpolation);
+
+  std::vector<const Viper*> vipers;
+  for (auto& player : _players)
+    if (player->viper())
+      vipers.push_back(player->viper());
+  _viper_batch.pack(vipers,
+                    BoundingBox(_game_view.getCenter(), _game_view.getSize()),
+                    _interpolation);
+}
+
+/* Lowers the level of detail of the vipers until their vertices fit within the
+ * budget. The longest vipers are simplified first since they gain the most. */
+void ArenaScene::select_viper_detail_levels() {
+  std::vector<Viper*> vipers;
+  for (auto& player : _players)
+    if (player->viper())
+      vipers.push_back(player->viper());
+  if (vipers.empty())
+    return;
+  auto budget = vipers.front()->viper_configuration().vertex_budget;
+  if (budget <= 0)
+    return;
+
+  std::ranges::sort(vipers, std::ranges::greater(), [](const Viper* viper) {
+    return viper->estimated_vertex_count(0);
+  });
+  size_t number_of_vertices = 0;
+  for (auto viper : vipers)
+    number_of_vertices += viper->estimated_vertex_count(0);
+  std::vector<size_t> levels(vipers.size(), 0);
+  for (size_t level = 1; level < ViperConfiguration::number_of_detail_levels;
+       ++level) {
+    for (size_t i = 0;
+         i < vipers.size() && number_of_vertices > size_t(budget); ++i) {
+      number_of_vertices -= vipers[i]->estimated_vertex_count(level - 1) -
+                            vipers[i]->estimated_vertex_count(level);
+      levels[i] = level;
+    }
+  }
+  for (size_t i = 0; i < vipers.size(); ++i)
+    vipers[i]->set_detail_level(levels[i]);
+}
+
 void ArenaScene::update_objects(const Time& elapsed_time) {
+  PROFILE_FUNCTION();
   for (auto& food : _food) {
     food->update(elapsed_time);
   }
   for (auto& flying_score : _flying_scores) {
     flying_score->update(elapsed_time);
   }
-  for (auto& player : _players) {
+  select_viper_detail_levels();
+  // Steering is applied to the vipers through notifications
+  for (auto& player : _players)
     player->controller()->update(elapsed_time);
-    player->viper()->update(elapsed_time);
+  /* The vipers only touch their own state while updating, so they can be
+   * updated in parallel as long as their notifications are held back and sent
+   * from this thread afterwards. */
+  for (auto& player : _players)
+    player->viper()->defer_notifications(true);
+  _thread_pool.parallel_for(_players.size(), [&](size_t index) {
+    _players[index]->viper()->update(elapsed_time);
+  });
+  for (auto& player : _players) {
+    player->viper()->defer_notifications(false);
+    player->viper()->flush_notifications();
   }
 }
 
@@ -10,13 +10,17 @@
 #include <vvipers/GameElements/Controller.hpp>
 #include <vvipers/GameElements/FlyingScore.hpp>
 #include <vvipers/GameElements/Food.hpp>
+#include <vvipers/GameElements/FoodBatch.hpp>
 #include <vvipers/GameElements/GameEvent.hpp>
 #include <vvipers/GameElements/GameObject.hpp>
 #include <vvipers/GameElements/Observer.hpp>
 #include <vvipers/GameElements/Player.hpp>
 #include <vvipers/GameElements/Viper.hpp>
+#include <vvipers/GameElements/ViperBatch.hpp>
 #include <vvipers/GameElements/Walls.hpp>
+#include <vvipers/UIElements/NumberBatch.hpp>
 #include <vvipers/UIElements/PlayerPanel.hpp>
+#include <vvipers/Utilities/ThreadPool.hpp>
 #include <vvipers/Utilities/Time.hpp>
 
 namespace VVipers {
@@ -26,6 +30,8 @@ class ArenaScene : public Scene {
     ArenaScene(GameResources& game);
     ~ArenaScene();
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void interpolate(double interpolation) override;
+    bool take_snapshot(RenderSnapshot& snapshot) const override;
     void on_notify(const GameEvent& event) override;
     void update(const Time& elapsedTime) override;
 
@@ -63,8 +69,12 @@ class ArenaScene : public Scene {
     void handle_viper_viper_collision(Viper*, size_t, Viper*, size_t);
     void handle_viper_walls_collision(Viper*, size_t, Walls*, size_t);
     void kill_viper(Viper* viper);
+    void pack_render_batches();
+    /** @returns the transform from coordinates in view to window pixels **/
+    sf::Transform view_to_window_transform(const sf::View& view);
     void process_deletions();
     PlayerData read_player_conf(size_t player);
+    void select_viper_detail_levels();
     void update_objects(const Time& elapsedTime);
 
     sf::View _game_view;
@@ -80,6 +90,11 @@ class ArenaScene : public Scene {
 
     std::set<const GameObject*> _objects_to_delete;
     CollisionManager _collision_manager;
+    ThreadPool _thread_pool;
+    ViperBatch _viper_batch;
+    FoodBatch _food_batch;
+    NumberBatch _hud_numbers;
+    double _interpolation = 1;  // Between the last two updates
 };
 
 }  // namespace VVipers
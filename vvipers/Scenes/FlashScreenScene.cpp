@@ -12,7 +12,8 @@ namespace VVipers {
 FlashScreenScene::FlashScreenScene(GameResources& game_resources, Time duration)
     : Scene(game_resources), _time_left(duration) {
     Vec2 size = game_resources.window_manager().window_size();
-    _text.setFont(*game_resources.font_service().default_font());
+    if (auto font = game_resources.font_service().default_font())
+        _text.setFont(*font);
     _text.setString("Voracious Vipers");
     _text.setCharacterSize(0.1 * size.y);
     _text.setPosition(size / 2);
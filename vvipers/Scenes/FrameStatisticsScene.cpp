@@ -0,0 +1,77 @@
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <iomanip>
+#include <sstream>
+#include <vvipers/Engine/GameResources.hpp>
+#include <vvipers/Engine/RenderSnapshot.hpp>
+#include <vvipers/Scenes/FrameStatisticsScene.hpp>
+#include <vvipers/Utilities/Vec2.hpp>
+
+namespace VVipers {
+
+namespace {
+const Time refresh_interval = time_from_seconds(0.25);
+}  // namespace
+
+FrameStatisticsScene::FrameStatisticsScene(GameResources& game_resources,
+                                           const FrameStatistics& statistics)
+    : Scene(game_resources), _statistics(statistics), _time_to_refresh(0) {
+    Vec2 size = game_resources.window_manager().window_size();
+    if (auto font = game_resources.font_service().default_font())
+        _text.setFont(*font);
+    _text.setCharacterSize(std::max(10., 0.02 * size.y));
+    _text.setFillColor(sf::Color::White);
+    _text.setPosition(0.01 * size);
+    _background.setFillColor(sf::Color(0, 0, 0, 0xc0));
+    set_draw_state(DrawState::Transparent);
+    update_text();
+    // The columns have a fixed width, so the size of the text does not change.
+    // Measuring it later could race with the render thread over the font.
+    auto bounds = _text.getGlobalBounds();
+    double margin = 0.5 * _text.getCharacterSize();
+    _background.setPosition(bounds.left - margin, bounds.top - margin);
+    _background.setSize(
+        Vec2(bounds.width + 2 * margin, bounds.height + 2 * margin));
+}
+
+void FrameStatisticsScene::draw(sf::RenderTarget& target,
+                                sf::RenderStates states) const {
+    target.setView(target.getDefaultView());
+    target.draw(_background, states);
+    target.draw(_text, states);
+}
+
+bool FrameStatisticsScene::take_snapshot(RenderSnapshot& snapshot) const {
+    snapshot.set_view(game_resources().window_manager().default_view());
+    snapshot.add_copy(_background);
+    snapshot.add_copy(_text);
+    return true;
+}
+
+void FrameStatisticsScene::update(const Time& elapsed_time) {
+    _time_to_refresh -= elapsed_time;
+    if (_time_to_refresh <= time_from_seconds(0)) {
+        update_text();
+        _time_to_refresh = refresh_interval;
+    }
+}
+
+void FrameStatisticsScene::update_text() {
+    auto ms = [](Time time) { return 1000 * time_as_seconds(time); };
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << std::left << std::setw(6) << "ms" << std::right << std::setw(7)
+       << "mean" << std::setw(7) << "p50" << std::setw(7) << "p95"
+       << std::setw(7) << "p99";
+    for (int phase = 0; phase < FrameStatistics::NumberOfPhases; ++phase) {
+        auto p = FrameStatistics::Phase(phase);
+        ss << '\n'
+           << std::left << std::setw(6) << FrameStatistics::phase_name(p)
+           << std::right << std::setw(7) << ms(_statistics.mean(p))
+           << std::setw(7) << ms(_statistics.percentile(p, 0.50))
+           << std::setw(7) << ms(_statistics.percentile(p, 0.95))
+           << std::setw(7) << ms(_statistics.percentile(p, 0.99));
+    }
+    _text.setString(ss.str());
+}
+
+}  // namespace VVipers
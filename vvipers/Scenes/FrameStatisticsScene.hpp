@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <vvipers/Engine/Scene.hpp>
+#include <vvipers/Utilities/FrameStatistics.hpp>
+#include <vvipers/Utilities/Time.hpp>
+
+namespace VVipers {
+
+class GameResources;
+
+/** Shows the mean and percentiles of the frame timings in a corner. It is
+ * drawn on top of the other scenes and does not take part in the scene
+ * stack. **/
+class FrameStatisticsScene : public Scene {
+  public:
+    FrameStatisticsScene(GameResources& game_resources,
+                         const FrameStatistics& statistics);
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    bool take_snapshot(RenderSnapshot& snapshot) const override;
+    /** The text is only renewed a few times per second to be readable **/
+    void update(const Time& elapsed_time) override;
+
+  private:
+    void update_text();
+
+    const FrameStatistics& _statistics;
+    Time _time_to_refresh;
+    sf::RectangleShape _background;
+    sf::Text _text;
+};
+
+}  // namespace VVipers
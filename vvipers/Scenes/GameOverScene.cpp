@@ -17,7 +17,8 @@ GameOverScene::GameOverScene(GameResources& game,
                              std::vector<const Player*> players)
     : Scene(game), _players(players) {
     Vec2 size = game.window_manager().window_size();
-    _game_over_text.setFont(*game.font_service().default_font());
+    if (auto font = game.font_service().default_font())
+        _game_over_text.setFont(*font);
     _game_over_text.setString("Game Over");
     _game_over_text.setCharacterSize(0.1 * size.y);
     _game_over_text.setPosition(size / 2);
@@ -28,7 +29,8 @@ GameOverScene::GameOverScene(GameResources& game,
     _game_over_text.setOutlineColor(game.color_service().get_color(1));
     _game_over_text.setOutlineThickness(0.005 * size.y);
 
-    _score_text.setFont(*game.font_service().default_font());
+    if (auto font = game.font_service().default_font())
+        _score_text.setFont(*font);
     _score_text.setString(score_string(players));
     _score_text.setCharacterSize(0.5 * _game_over_text.getCharacterSize());
     _score_text.setPosition(_game_over_text.getPosition() +
@@ -32,7 +32,7 @@ MainMenuScene::MainMenuScene(GameResources& game) : MenuScene(game) {
     distribute_menu_items();
     set_selected_index(0);
     set_colors(sf::Color::Transparent, game.color_service().get_color(0));
-    set_texts(*game.font_service().default_font(),
+    set_texts(game.font_service().default_font(),
               game.color_service().get_color(1));
 }
 
@@ -41,15 +41,17 @@ void MainMenuScene::on_menu_item_activation(MenuItem* menuItem) {
         set_run_state(RunState::Paused);
         set_draw_state(DrawState::Skip);
         SceneEvent scene_event(SceneEvent::SceneEventType::Spawn);
-        scene_event.target_scene =
-            std::make_shared<ArenaScene>(game_resources());
+        scene_event.scene_factory = [&game = game_resources()] {
+            return std::make_shared<ArenaScene>(game);
+        };
         notify(scene_event);
     } else if (menuItem == _options_button.get()) {
         set_run_state(RunState::Paused);
         set_draw_state(DrawState::Skip);
         SceneEvent scene_event(SceneEvent::SceneEventType::Spawn);
-        scene_event.target_scene =
-            std::make_shared<OptionsMenuScene>(game_resources());
+        scene_event.scene_factory = [&game = game_resources()] {
+            return std::make_shared<OptionsMenuScene>(game);
+        };
         notify(scene_event);
     } else if (menuItem == _quit_button.get()) {
         set_run_state(RunState::Paused);
@@ -39,7 +39,7 @@ OptionsMenuScene::OptionsMenuScene(GameResources& game) : MenuScene(game) {
     distribute_menu_items();
     set_draw_state(DrawState::Transparent);
     set_colors(sf::Color::Transparent, game.color_service().get_color(0));
-    set_texts(*game.font_service().default_font(),
+    set_texts(game.font_service().default_font(),
               game.color_service().get_color(1));
 }
 
@@ -48,8 +48,9 @@ void OptionsMenuScene::on_menu_item_activation(MenuItem* menuItem) {
         set_run_state(RunState::Paused);
         set_draw_state(DrawState::Skip);
         SceneEvent scene_event(SceneEvent::SceneEventType::Spawn);
-        scene_event.target_scene =
-            std::make_shared<PlayerConfScene>(game_resources());
+        scene_event.scene_factory = [&game = game_resources()] {
+            return std::make_shared<PlayerConfScene>(game);
+        };
         notify(scene_event);
     } else if (menuItem == _back_button.get()) {
         go_back();
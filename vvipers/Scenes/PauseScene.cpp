@@ -38,7 +38,7 @@ PauseScene::PauseScene(GameResources& game) : MenuScene(game) {
     distribute_menu_items();
 
     set_colors(sf::Color::Transparent, game.color_service().get_color(0));
-    set_texts(*game.font_service().default_font(),
+    set_texts(game.font_service().default_font(),
               game.color_service().get_color(1));
 
     set_draw_state(DrawState::Transparent);
@@ -55,7 +55,7 @@ PlayerConfScene::PlayerConfScene(GameResources& game)
 
     set_draw_state(DrawState::Transparent);
     set_colors(sf::Color::Transparent, game.color_service().get_color(0));
-    set_texts(*game.font_service().default_font(),
+    set_texts(game.font_service().default_font(),
               game.color_service().get_color(1));
     set_selected_index(0);
     update_labels();
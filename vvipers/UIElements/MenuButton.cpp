@@ -58,8 +58,9 @@ void MenuButton::set_colors(sf::Color fill, sf::Color border) {
     update_colors();
 }
 
-void MenuButton::set_text(const sf::Font& font, sf::Color text_color) {
-    _text.setFont(font);
+void MenuButton::set_text(const sf::Font* font, sf::Color text_color) {
+    if (font)
+        _text.setFont(*font);
     _text_color = text_color;
     update_colors();
     on_geometry_change();
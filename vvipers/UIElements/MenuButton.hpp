@@ -13,7 +13,7 @@ class MenuButton : public MenuItem {
     void on_geometry_change() override;
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
     void on_selection() override;
-    void set_text(const sf::Font& font, sf::Color text_color) override;
+    void set_text(const sf::Font* font, sf::Color text_color) override;
     void set_label(const std::string& label);
     void set_colors(sf::Color fill, sf::Color border) override;
     void on_enable() override;
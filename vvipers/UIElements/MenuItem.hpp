@@ -22,7 +22,7 @@ class MenuItem : public sf::Drawable, public Object, public Observable {
     virtual void draw(sf::RenderTarget& target,
                       sf::RenderStates states) const override {}
     virtual void set_colors(sf::Color fill, sf::Color border) {};
-    virtual void set_text(const sf::Font& font, sf::Color text_color) {};
+    virtual void set_text(const sf::Font* font, sf::Color text_color) {};
     virtual void update(Time elapsedTime) {};
     void set_selected(bool selected);
     bool is_selected() const { return _selected; }
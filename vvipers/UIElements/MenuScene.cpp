@@ -60,7 +60,7 @@ void MenuScene::set_colors(sf::Color fill, sf::Color border) {
     }
 }
 
-void MenuScene::set_texts(const sf::Font& font, sf::Color text_color) {
+void MenuScene::set_texts(const sf::Font* font, sf::Color text_color) {
     for (auto menu_item : _menu_items) {
         menu_item->set_text(font, text_color);
     }
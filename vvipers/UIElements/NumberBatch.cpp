@@ -0,0 +1,90 @@
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <vvipers/UIElements/NumberBatch.hpp>
+
+namespace VVipers {
+
+namespace {
+// The outline is this fraction of the glyph size
+const float outline_fraction = 1.f / 16;
+}  // namespace
+
+NumberBatch::NumberBatch(const sf::Font* font, unsigned int glyph_size)
+    : _font(font), _glyph_size(glyph_size) {
+    if (!_font)
+        return;
+    // Fetching the glyphs rasterises them into the font texture
+    for (size_t i = 0; i < characters.size(); ++i) {
+        _glyphs[i] = _font->getGlyph(characters[i], _glyph_size, false);
+        _outline_glyphs[i] = _font->getGlyph(characters[i], _glyph_size, false,
+                                             outline_fraction * _glyph_size);
+    }
+}
+
+void NumberBatch::add_text(std::string_view text, Vec2 position,
+                           double character_size, sf::Color color,
+                           sf::Color outline_color,
+                           const sf::Transform& transform) {
+    if (!_font)
+        return;
+    double scale = character_size / _glyph_size;
+    double width = 0;
+    for (auto character : text) {
+        auto index = characters.find(character);
+        if (index != std::string_view::npos)
+            width += _glyphs[index].advance;
+    }
+    // Centred vertically on the digits, which all have the same height
+    const auto& digit_bounds = _glyphs[0].bounds;
+    Vec2 origin =
+        position - scale * Vec2(0.5 * width,
+                                digit_bounds.top + 0.5 * digit_bounds.height);
+    if (outline_color.a > 0)
+        add_glyphs(_outline_glyphs, text, origin, scale, outline_color,
+                   transform);
+    add_glyphs(_glyphs, text, origin, scale, color, transform);
+}
+
+void NumberBatch::add_glyphs(
+    const std::array<sf::Glyph, characters.size()>& glyphs,
+    std::string_view text, Vec2 origin, double scale, sf::Color color,
+    const sf::Transform& transform) {
+    for (auto character : text) {
+        auto index = characters.find(character);
+        if (index == std::string_view::npos)
+            continue;
+        const auto& glyph = glyphs[index];
+        // Characters advance by the size of the plain glyphs
+        double advance = _glyphs[index].advance;
+        Vec2 top_left =
+            origin + scale * Vec2(glyph.bounds.left, glyph.bounds.top);
+        Vec2 size = scale * Vec2(glyph.bounds.width, glyph.bounds.height);
+        float u1 = glyph.textureRect.left;
+        float v1 = glyph.textureRect.top;
+        float u2 = u1 + glyph.textureRect.width;
+        float v2 = v1 + glyph.textureRect.height;
+        auto vertex = [&](double x, double y, float u, float v) {
+            return sf::Vertex(
+                transform.transformPoint(sf::Vector2f(top_left.x + x * size.x,
+                                                      top_left.y + y * size.y)),
+                color, {u, v});
+        };
+        _vertices.push_back(vertex(0, 0, u1, v1));
+        _vertices.push_back(vertex(1, 0, u2, v1));
+        _vertices.push_back(vertex(0, 1, u1, v2));
+        _vertices.push_back(vertex(0, 1, u1, v2));
+        _vertices.push_back(vertex(1, 0, u2, v1));
+        _vertices.push_back(vertex(1, 1, u2, v2));
+        origin.x += scale * advance;
+    }
+}
+
+void NumberBatch::draw(sf::RenderTarget& target,
+                       sf::RenderStates states) const {
+    if (_vertices.empty())
+        return;
+    states.texture = texture();
+    target.draw(_vertices.data(), _vertices.size(),
+                sf::PrimitiveType::Triangles, states);
+}
+
+}  // namespace VVipers
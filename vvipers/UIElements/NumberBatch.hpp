@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Glyph.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <vvipers/Utilities/Vec2.hpp>
+
+namespace VVipers {
+
+/** A short string kept on the stack, for formatting numbers without
+ * allocating. **/
+class NumberString {
+  public:
+    NumberString& operator<<(int64_t number) {
+        auto result = std::to_chars(_characters.data() + _length,
+                                    _characters.data() + _characters.size(),
+                                    number);
+        _length = result.ptr - _characters.data();
+        return *this;
+    }
+    NumberString& operator<<(std::string_view text) {
+        for (auto character : text)
+            if (_length < _characters.size())
+                _characters[_length++] = character;
+        return *this;
+    }
+    void clear() { _length = 0; }
+    std::string_view view() const { return {_characters.data(), _length}; }
+
+  private:
+    std::array<char, 32> _characters;
+    size_t _length = 0;
+};
+
+/** Draws numbers, and the few characters that go with them, as quads with
+ * glyphs from a font rasterised once. The glyphs are scaled to any character
+ * size, so all numbers written to the batch share one texture and are drawn
+ * with one call. **/
+class NumberBatch : public sf::Drawable {
+  public:
+    static constexpr std::string_view characters = "0123456789+-/%. ";
+
+    NumberBatch(const sf::Font* font, unsigned int glyph_size = 64);
+    void clear() { _vertices.clear(); }
+    /** Writes the text centred on position, transformed by transform. The
+     * outline is only drawn if its colour is not transparent. **/
+    void add_text(std::string_view text, Vec2 position, double character_size,
+                  sf::Color color,
+                  sf::Color outline_color = sf::Color::Transparent,
+                  const sf::Transform& transform = sf::Transform::Identity);
+    const std::vector<sf::Vertex>& vertices() const { return _vertices; }
+    /** @returns null without a font, when nothing is written **/
+    const sf::Texture* texture() const {
+        return _font ? &_font->getTexture(_glyph_size) : nullptr;
+    }
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+  private:
+    void add_glyphs(const std::array<sf::Glyph, characters.size()>& glyphs,
+                    std::string_view text, Vec2 origin, double scale,
+                    sf::Color color, const sf::Transform& transform);
+
+    const sf::Font* _font;
+    unsigned int _glyph_size;
+    std::array<sf::Glyph, characters.size()> _glyphs;
+    std::array<sf::Glyph, characters.size()> _outline_glyphs;
+    std::vector<sf::Vertex> _vertices;  // Triangles
+};
+
+}  // namespace VVipers
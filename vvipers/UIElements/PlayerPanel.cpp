@@ -1,4 +1,5 @@
 #include <vvipers/Engine/Providers.hpp>
+#include <vvipers/Engine/RenderSnapshot.hpp>
 #include <vvipers/GameElements/Viper.hpp>
 #include <vvipers/UIElements/PlayerPanel.hpp>
 
@@ -11,7 +12,8 @@ PlayerPanel::PlayerPanel(sf::View view, const Player* player,
     : _view(view), _player(player), _score(player->score()) {
     _font = font_provider.default_font();
     // Set text properties
-    _name_text.setFont(*_font);
+    if (_font)
+        _name_text.setFont(*_font);
     const int characterSize = 0.25 * _view.getSize().y;  // px
     _name_text.setCharacterSize(characterSize);
     // Set the name string and the position (dependent on string size)
@@ -43,9 +45,9 @@ PlayerPanel::PlayerPanel(sf::View view, const Player* player,
     _score_bar.set_border_width(2);
     _score_bar.set_bar_color(player->secondary_color());
     _score_bar.set_border_color(player->primary_color());
-    _score_bar.set_text_properties(_font, 0.8 * characterSize,
-                                 player->primary_color(),
-                                 ProgressBar::ProgressTextStyle::IntegerRatio);
+    _score_bar.set_text_properties(
+        0.8 * characterSize, player->primary_color(),
+        ProgressBar::ProgressTextStyle::IntegerRatio);
     _score_bar.set_show_text(true);
     update_score_string();
 }
@@ -57,6 +59,17 @@ void PlayerPanel::draw(sf::RenderTarget& target,
     target.draw(_boost_bar, states);
 }
 
+void PlayerPanel::take_snapshot(RenderSnapshot& snapshot) const {
+    snapshot.add_copy(_name_text);
+    snapshot.add_copy(_score_bar);
+    snapshot.add_copy(_boost_bar);
+}
+
+void PlayerPanel::write_numbers(NumberBatch& numbers,
+                                const sf::Transform& view_transform) const {
+    _score_bar.write_text(numbers, view_transform);
+}
+
 void PlayerPanel::on_notify(const GameEvent& event) {
     if (event.type() == GameEvent::EventType::Scoring) {
         const ScoringEvent& scoringEvent =
@@ -12,12 +12,19 @@
 namespace VVipers {
 
 class FontProvider;
+class RenderSnapshot;
 
 class PlayerPanel : public sf::Drawable, public Observer {
   public:
     PlayerPanel(sf::View view, const Player* player,
                 const FontProvider& font_provider);
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    /** Adds copies of what draw draws **/
+    void take_snapshot(RenderSnapshot& snapshot) const;
+    /** Writes the numbers of the panel, transformed from the view of the panel
+     * to where they should be drawn **/
+    void write_numbers(NumberBatch& numbers,
+                       const sf::Transform& view_transform) const;
     void on_notify(const GameEvent& event) override;
     const Player* player() const { return _player; }
     Vec2 score_target() const;
@@ -1,5 +1,4 @@
 #include <SFML/Graphics/RenderTarget.hpp>
-#include <sstream>
 #include <vvipers/UIElements/ProgressBar.hpp>
 #include <vvipers/Utilities/debug.hpp>
 
@@ -11,6 +10,8 @@ ProgressBar::ProgressBar()
       _progress_low(0.),
       _progress_high(1.),
       _show_text(false),
+      _character_size(0),
+      _text_color(sf::Color::White),
       _text_style(ProgressTextStyle::Percent) {
     set_progress(_progress_low);
     set_size(_size);
@@ -25,7 +26,14 @@ void ProgressBar::draw(sf::RenderTarget& target,
                        sf::RenderStates states) const {
     target.draw(_bar_rectangle, states);
     target.draw(_main_rectangle, states);
-    target.draw(_text, states);
+}
+
+void ProgressBar::write_text(NumberBatch& numbers,
+                             const sf::Transform& transform) const {
+    if (_show_text)
+        numbers.add_text(_text.view(), _position + 0.5 * _size,
+                         _character_size, _text_color,
+                         sf::Color::Transparent, transform);
 }
 
 void ProgressBar::set_position(Vec2 position) {
@@ -55,12 +63,10 @@ void ProgressBar::set_size(Vec2 size) {
     update_bar();
 }
 
-void ProgressBar::set_text_properties(const sf::Font* font,
-                                      double character_size, sf::Color color,
+void ProgressBar::set_text_properties(double character_size, sf::Color color,
                                       ProgressTextStyle style) {
-    _text.setFont(*font);
-    _text.setCharacterSize(character_size);
-    _text.setFillColor(color);
+    _character_size = character_size;
+    _text_color = color;
     _text_style = style;
 }
 
@@ -92,23 +98,19 @@ void ProgressBar::update_bar() {
         _bar_rectangle.setPosition(_position.x + barStart, _position.y);
     }
     if (_show_text) {
-        std::stringstream ss;
+        _text.clear();
         switch (_text_style) {
             case ProgressTextStyle::IntegerRatio: {
-                ss << int(_progress) << " / " << int(_progress_high);
+                _text << int64_t(_progress) << " / " << int64_t(_progress_high);
                 break;
             }
             case ProgressTextStyle::Percent: {
-                ss << int(100 * (_progress - _progress_low) /
-                          (_progress_high - _progress_low))
-                   << '%';
+                _text << int64_t(100 * (_progress - _progress_low) /
+                                 (_progress_high - _progress_low))
+                      << "%";
                 break;
             }
         }
-        _text.setString(ss.str());
-        auto lb = _text.getLocalBounds();
-        _text.setOrigin(lb.left + 0.5 * lb.width, lb.top + 0.5 * lb.height);
-        _text.setPosition(_position + 0.5 * _size);
     }
 }
 
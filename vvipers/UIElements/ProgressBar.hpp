@@ -2,9 +2,9 @@
 
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Drawable.hpp>
-#include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <vvipers/UIElements/NumberBatch.hpp>
 #include <vvipers/Utilities/Vec2.hpp>
 
 namespace VVipers {
@@ -15,7 +15,11 @@ class ProgressBar : public sf::Drawable {
 
     ProgressBar();
 
+    /** Draws the bar, the text is written separately by write_text **/
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    /** Writes the progress text, transformed by transform, if it is shown **/
+    void write_text(NumberBatch& numbers,
+                    const sf::Transform& transform) const;
 
     Vec2 position() const { return _position; }
     sf::FloatRect local_bounds() const {
@@ -37,8 +41,8 @@ class ProgressBar : public sf::Drawable {
     void set_progress_limits(double low, double high);
     void set_show_text(bool show) { _show_text = show; }
     void set_size(Vec2 size);
-    void set_text_properties(const sf::Font* font, double sizeRatio,
-                             sf::Color color, ProgressTextStyle style);
+    void set_text_properties(double characterSize, sf::Color color,
+                             ProgressTextStyle style);
     void set_position(Vec2 pos);
     void set_progress(double progress);
     void set_vertical(bool vertical);
@@ -55,7 +59,9 @@ class ProgressBar : public sf::Drawable {
     double _progress_low;
     double _progress_high;
     bool _show_text;
-    sf::Text _text;
+    NumberString _text;
+    double _character_size;
+    sf::Color _text_color;
     ProgressTextStyle _text_style;
     sf::RectangleShape _main_rectangle;
     sf::RectangleShape _bar_rectangle;
@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <thread>
+#include <vvipers/Utilities/FramePacer.hpp>
+
+namespace VVipers {
+
+FramePacer::FramePacer(Time frame_duration, Time spin_margin)
+    : _frame_duration(frame_duration),
+      _spin_margin(spin_margin),
+      _started(false),
+      _waiting(true),
+      _last_error(0) {}
+
+void FramePacer::wait_for_next_frame() {
+    auto frame = std::chrono::duration_cast<Clock::duration>(_frame_duration);
+    if (!_started) {
+        _started = true;
+        _deadline = Clock::now() + frame;
+    }
+    if (_waiting) {
+        auto margin = std::chrono::duration_cast<Clock::duration>(_spin_margin);
+        if (Clock::now() < _deadline - margin)
+            std::this_thread::sleep_until(_deadline - margin);
+        while (Clock::now() < _deadline)
+            std::this_thread::yield();
+    }
+    auto now = Clock::now();
+    record_error(now - _deadline);
+    _deadline += frame;
+    // A frame that ran over by more than a whole frame is not caught up with,
+    // the schedule starts over instead
+    if (_deadline < now)
+        _deadline = now + frame;
+}
+
+void FramePacer::record_error(Time error) {
+    _last_error = error;
+    Time absolute_error = error < Time(0) ? -error : error;
+    ++_statistics.frames;
+    if (error > _spin_margin)
+        ++_statistics.late_frames;
+    _statistics.mean_error +=
+        (absolute_error - _statistics.mean_error) / double(_statistics.frames);
+    _statistics.max_error = std::max(_statistics.max_error, absolute_error);
+}
+
+}  // namespace VVipers
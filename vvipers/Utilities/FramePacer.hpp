@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <vvipers/Utilities/Time.hpp>
+
+namespace VVipers {
+
+/** Keeps frames on a fixed schedule. Most of the wait is slept away, the last
+ * part is spent yielding since sleeping often overshoots by a millisecond or
+ * more. Frames are scheduled from the previous deadline rather than from when
+ * the previous frame ended, so small delays do not add up. **/
+class FramePacer {
+  public:
+    struct Statistics {
+        size_t frames = 0;
+        size_t late_frames = 0;  // Woke up more than the spin margin late
+        Time mean_error = Time(0);   // Of the absolute error
+        Time max_error = Time(0);
+    };
+
+    FramePacer(Time frame_duration,
+               Time spin_margin = std::chrono::milliseconds(2));
+    /** Waits until the start of the next frame. If waiting is disabled, e.g.
+     * when displaying already waits for the vertical sync, the error is only
+     * measured. **/
+    void wait_for_next_frame();
+    Time frame_duration() const { return _frame_duration; }
+    /** How late, or early if negative, the last frame started **/
+    Time last_error() const { return _last_error; }
+    const Statistics& statistics() const { return _statistics; }
+    void reset_statistics() { _statistics = Statistics(); }
+    void set_waiting(bool waiting) { _waiting = waiting; }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    void record_error(Time error);
+
+    Time _frame_duration;
+    Time _spin_margin;
+    Clock::time_point _deadline;
+    bool _started;
+    bool _waiting;
+    Time _last_error;
+    Statistics _statistics;
+};
+
+}  // namespace VVipers
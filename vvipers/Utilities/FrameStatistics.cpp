@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vvipers/Utilities/FrameStatistics.hpp>
+
+namespace VVipers {
+
+FrameStatistics::FrameStatistics(size_t capacity)
+    : _capacity(capacity), _next(0) {
+    if (capacity == 0)
+        throw std::invalid_argument("FrameStatistics needs a capacity.");
+    _samples.reserve(capacity);
+    for (auto& sorted : _sorted)
+        sorted.reserve(capacity);
+    _sums.fill(0.);
+}
+
+void FrameStatistics::add(const Timings& timings) {
+    for (size_t phase = 0; phase < NumberOfPhases; ++phase) {
+        auto& sorted = _sorted[phase];
+        if (_samples.size() == _capacity) {
+            double old_value = time_as_seconds(_samples[_next][phase]);
+            sorted.erase(std::lower_bound(sorted.begin(), sorted.end(),
+                                          old_value));
+            _sums[phase] -= old_value;
+        }
+        double value = time_as_seconds(timings[phase]);
+        sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), value),
+                      value);
+        _sums[phase] += value;
+    }
+    if (_samples.size() < _capacity) {
+        _samples.push_back(timings);
+    } else {
+        _samples[_next] = timings;
+        _next = (_next + 1) % _capacity;
+    }
+}
+
+const FrameStatistics::Timings& FrameStatistics::timings(size_t age) const {
+    if (age >= _samples.size())
+        throw std::out_of_range("No timings that old.");
+    size_t latest = _samples.size() < _capacity
+                        ? _samples.size() - 1
+                        : (_next + _capacity - 1) % _capacity;
+    return _samples[(latest + _capacity - age) % _capacity];
+}
+
+Time FrameStatistics::mean(Phase phase) const {
+    if (_samples.empty())
+        return Time(0);
+    return time_from_seconds(_sums[phase] / _samples.size());
+}
+
+// Nearest rank
+Time FrameStatistics::percentile(Phase phase, double fraction) const {
+    const auto& sorted = _sorted[phase];
+    if (sorted.empty())
+        return Time(0);
+    size_t rank = std::ceil(std::clamp(fraction, 0., 1.) * sorted.size());
+    return time_from_seconds(sorted[std::max<size_t>(rank, 1) - 1]);
+}
+
+std::string FrameStatistics::phase_name(Phase phase) {
+    switch (phase) {
+        case Frame:
+            return "Frame";
+        case Update:
+            return "Update";
+        case Events:
+            return "Events";
+        case Draw:
+            return "Draw";
+        case Wait:
+            return "Wait";
+        case Lateness:
+            return "Late";
+        default:
+            return "";
+    }
+}
+
+}  // namespace VVipers
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <vvipers/Utilities/Time.hpp>
+
+namespace VVipers {
+
+/** Keeps the timings of the most recent frames in a ring buffer. Every phase
+ * is also kept sorted, which is updated as frames come and go, so that the
+ * mean and percentiles can be asked for every frame. **/
+class FrameStatistics {
+  public:
+    enum Phase { Frame, Update, Events, Draw, Wait, Lateness, NumberOfPhases };
+    using Timings = std::array<Time, NumberOfPhases>;
+
+    FrameStatistics(size_t capacity = 256);
+    void add(const Timings& timings);
+    size_t capacity() const { return _capacity; }
+    size_t size() const { return _samples.size(); }
+    /** The timings of the frame age frames ago, 0 being the latest **/
+    const Timings& timings(size_t age = 0) const;
+    Time mean(Phase phase) const;
+    /** @returns the smallest timing that fraction of the frames do not
+     * exceed, e.g. 0.95 for the 95th percentile **/
+    Time percentile(Phase phase, double fraction) const;
+    static std::string phase_name(Phase phase);
+
+  private:
+    size_t _capacity;
+    size_t _next;  // Where the next frame goes once the buffer is full
+    std::vector<Timings> _samples;
+    std::array<std::vector<double>, NumberOfPhases> _sorted;  // s
+    std::array<double, NumberOfPhases> _sums;                 // s
+};
+
+}  // namespace VVipers
@@ -0,0 +1,105 @@
+#include <chrono>
+#include <cstdlib>
+#include <vvipers/Utilities/Logger.hpp>
+#include <vvipers/Utilities/debug.hpp>
+
+namespace VVipers {
+
+Logger& Logger::instance() {
+    // Never destroyed, so that objects with static storage can still log
+    // while being destroyed
+    static Logger* logger = [] {
+        Logger* logger = new Logger;
+        std::atexit([] { instance().stop(); });
+        return logger;
+    }();
+    return *logger;
+}
+
+Logger::Logger()
+    : _records(new Record[capacity]),
+      _enqueue_position(0),
+      _dequeue_position(0),
+      _stopped(false),
+      _pushing(0) {
+    for (size_t i = 0; i < capacity; ++i)
+        _records[i].sequence.store(i, std::memory_order_relaxed);
+    _thread = std::thread(&Logger::work, this);
+    _thread.detach();
+}
+
+void Logger::stop() {
+    _stopped.store(true);
+    // Producers that missed _stopped still get their records into the queue
+    while (_pushing.load() > 0)
+        std::this_thread::yield();
+    flush();
+}
+
+/* A bounded multi-producer queue where every record carries a sequence
+ * number. A record may be claimed when its sequence equals the position, and
+ * is ready to be read when it is one past. Never returns null. */
+Logger::Record* Logger::claim_record() {
+    uint64_t position = _enqueue_position.load(std::memory_order_relaxed);
+    while (true) {
+        Record& record = _records[position % capacity];
+        uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+        if (sequence == position) {
+            if (_enqueue_position.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed))
+                return &record;
+        } else if (sequence < position) {
+            // Full, wait for the logging thread
+            _wake.notify_one();
+            std::this_thread::yield();
+            position = _enqueue_position.load(std::memory_order_relaxed);
+        } else {
+            position = _enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::publish(Record* record) {
+    uint64_t position = record->sequence.load(std::memory_order_relaxed);
+    record->sequence.store(position + 1, std::memory_order_release);
+    _wake.notify_one();
+}
+
+void Logger::write_header(std::ostream& os, bool do_tag,
+                          const std::source_location& location,
+                          const char* prefix) {
+    if (do_tag)
+        tag(location, os);
+    os << prefix;
+}
+
+void Logger::flush() {
+    uint64_t target = _enqueue_position.load(std::memory_order_acquire);
+    while (_dequeue_position.load(std::memory_order_acquire) < target) {
+        _wake.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+void Logger::work() {
+    uint64_t position = 0;
+    while (true) {
+        Record& record = _records[position % capacity];
+        if (record.sequence.load(std::memory_order_acquire) == position + 1) {
+            write_header(*record.os, record.do_tag, record.location,
+                         record.prefix);
+            record.write_arguments(record.storage, *record.os);
+            *record.os << '\n';
+            record.sequence.store(position + capacity,
+                                  std::memory_order_release);
+            _dequeue_position.store(++position, std::memory_order_release);
+            continue;
+        }
+        std::unique_lock lock(_mutex);
+        // Pushing does not lock, so a wake-up can be missed. The timeout
+        // bounds how long a record waits then.
+        _wake.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+}  // namespace VVipers
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+namespace VVipers {
+
+/** Writes log records on a thread of its own. Callers only copy the arguments
+ * into a record of a bounded lock-free queue, the formatting happens on the
+ * logging thread. Arguments too large for a record are formatted by the
+ * caller, and if the queue is full the caller waits for a free record. At
+ * exit the queue is flushed and any later records are written directly. **/
+class Logger {
+  public:
+    static Logger& instance();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /** Character arrays are copied into the record. Character pointers and
+     * string views are copied into strings, since what they point to might
+     * not live until the record is written. **/
+    template <typename... Args>
+    void push(std::ostream& os, bool do_tag,
+              const std::source_location& location, const char* prefix,
+              Args&&... args);
+    /** Waits until everything pushed before the call has been written **/
+    void flush();
+
+  private:
+    static const size_t capacity = 1024;  // A power of two
+    static const size_t storage_size = 192;
+
+    struct Record {
+        std::atomic<uint64_t> sequence;
+        std::ostream* os;
+        bool do_tag;
+        std::source_location location;
+        const char* prefix;
+        // Writes and destroys the arguments
+        void (*write_arguments)(std::byte* storage, std::ostream& os);
+        alignas(std::max_align_t) std::byte storage[storage_size];
+    };
+
+    // A character array copied without allocating
+    template <size_t N>
+    struct Characters {
+        Characters(const char (&text)[N]) { std::copy_n(text, N, characters); }
+        friend std::ostream& operator<<(std::ostream& os,
+                                        const Characters& text) {
+            return os << std::string_view(text.characters,
+                                          std::find(text.characters,
+                                                    text.characters + N, '\0'));
+        }
+        char characters[N];
+    };
+    template <typename T>
+    struct Storage {
+        using type = std::conditional_t<std::is_same_v<T, const char*> ||
+                                            std::is_same_v<T, char*> ||
+                                            std::is_same_v<T, std::string_view>,
+                                        std::string, T>;
+    };
+    template <size_t N>
+    struct Storage<char[N]> {
+        using type = Characters<N>;
+    };
+    template <typename T>
+    using Stored = typename Storage<std::remove_cvref_t<T>>::type;
+
+    template <typename Tuple>
+    static void write_tuple(std::byte* storage, std::ostream& os) {
+        auto arguments = std::launder(reinterpret_cast<Tuple*>(storage));
+        std::apply([&os](const auto&... a) { (os << ... << a); }, *arguments);
+        arguments->~Tuple();
+    }
+
+    Logger();
+    void stop();
+    Record* claim_record();
+    void publish(Record* record);
+    static void write_header(std::ostream& os, bool do_tag,
+                             const std::source_location& location,
+                             const char* prefix);
+    void work();
+
+    std::unique_ptr<Record[]> _records;
+    alignas(64) std::atomic<uint64_t> _enqueue_position;
+    alignas(64) std::atomic<uint64_t> _dequeue_position;
+    std::mutex _mutex;  // Only for sleeping
+    std::condition_variable _wake;
+    std::atomic<bool> _stopped;
+    std::atomic<size_t> _pushing;  // Producers that may still claim a record
+    std::thread _thread;
+};
+
+template <typename... Args>
+void Logger::push(std::ostream& os, bool do_tag,
+                  const std::source_location& location, const char* prefix,
+                  Args&&... args) {
+    using Tuple = std::tuple<Stored<Args>...>;
+    if constexpr (sizeof(Tuple) > storage_size ||
+                  alignof(Tuple) > alignof(std::max_align_t)) {
+        std::ostringstream text;
+        (text << ... << std::forward<Args>(args));
+        push(os, do_tag, location, prefix, std::move(text).str());
+    } else {
+        // Counted before looking at _stopped, so that stop() either is seen
+        // here or waits for this record
+        _pushing.fetch_add(1);
+        if (_stopped.load()) {
+            _pushing.fetch_sub(1);
+            write_header(os, do_tag, location, prefix);
+            (os << ... << std::forward<Args>(args)) << '\n';
+            return;
+        }
+        Record* record = claim_record();
+        record->os = &os;
+        record->do_tag = do_tag;
+        record->location = location;
+        record->prefix = prefix;
+        new (record->storage) Tuple(std::forward<Args>(args)...);
+        record->write_arguments = &write_tuple<Tuple>;
+        publish(record);
+        _pushing.fetch_sub(1);
+    }
+}
+
+}  // namespace VVipers
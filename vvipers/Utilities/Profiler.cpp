@@ -0,0 +1,77 @@
+#include <vvipers/Utilities/Profiler.hpp>
+
+namespace VVipers {
+
+namespace {
+void write_escaped(std::ostream& os, const char* text) {
+    for (; *text; ++text) {
+        if (*text == '"' || *text == '\\')
+            os << '\\';
+        os << *text;
+    }
+}
+}  // namespace
+
+bool Profiler::ThreadBuffer::push(const Zone& zone) {
+    uint64_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == capacity)
+        return false;
+    _zones[head % capacity] = zone;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void Profiler::ThreadBuffer::take(std::vector<Zone>& zones) {
+    uint64_t tail = _tail.load(std::memory_order_relaxed);
+    uint64_t head = _head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail)
+        zones.push_back(_zones[tail % capacity]);
+    _tail.store(tail, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer& Profiler::thread_buffer() {
+    // The buffers are kept when their threads end, so that their zones can
+    // still be written
+    thread_local ThreadBuffer* buffer = [] {
+        std::lock_guard lock(_mutex);
+        _buffers.push_back(std::make_unique<ThreadBuffer>(_buffers.size() + 1));
+        return _buffers.back().get();
+    }();
+    return *buffer;
+}
+
+void Profiler::record(const char* name, Clock::time_point begin,
+                      Clock::duration duration) {
+    if (!thread_buffer().push({name, begin - _start, duration}))
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t Profiler::dropped_zones() {
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+// Complete events ("ph":"X") with times in microseconds
+void Profiler::write_chrome_trace(std::ostream& os) {
+    std::lock_guard lock(_mutex);
+    auto microseconds = [](Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    std::vector<Zone> zones;
+    for (const auto& buffer : _buffers) {
+        zones.clear();
+        buffer->take(zones);
+        for (const auto& zone : zones) {
+            os << (first ? "\n" : ",\n") << "{\"name\":\"";
+            write_escaped(os, zone.name);
+            os << "\",\"ph\":\"X\",\"ts\":" << microseconds(zone.begin)
+               << ",\"dur\":" << microseconds(zone.duration)
+               << ",\"pid\":1,\"tid\":" << buffer->thread_id() << "}";
+            first = false;
+        }
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+}  // namespace VVipers
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include <vvipers/config.hpp>
+
+namespace VVipers {
+
+/** Collects the zones recorded by PROFILE_ZONE and writes them as Chrome
+ * trace events, which chrome://tracing and Perfetto show as a timeline. Every
+ * thread writes into its own ring buffer without locking. A full buffer drops
+ * new zones until it is written out. **/
+class Profiler {
+  public:
+    using Clock = std::chrono::steady_clock;  // Never jumps
+
+    struct Zone {
+        const char* name;
+        Clock::duration begin;  // Since the profiler started
+        Clock::duration duration;
+    };
+
+    /** Called when a zone ends, by the thread it was in **/
+    static void record(const char* name, Clock::time_point begin,
+                       Clock::duration duration);
+    /** Writes the zones recorded since the last call as a JSON trace and
+     * removes them from the buffers **/
+    static void write_chrome_trace(std::ostream& os);
+    /** Zones dropped because a buffer was full **/
+    static size_t dropped_zones();
+
+  private:
+    class ThreadBuffer {
+      public:
+        static const size_t capacity = 1 << 16;
+        ThreadBuffer(size_t thread_id) : _thread_id(thread_id) {}
+        size_t thread_id() const { return _thread_id; }
+        bool push(const Zone& zone);
+        /** Only one thread at a time may take the zones **/
+        void take(std::vector<Zone>& zones);
+
+      private:
+        const size_t _thread_id;
+        std::unique_ptr<Zone[]> _zones{new Zone[capacity]};
+        std::atomic<uint64_t> _head{0};  // Written by the owning thread only
+        std::atomic<uint64_t> _tail{0};  // Written by the taking thread only
+    };
+
+    static ThreadBuffer& thread_buffer();
+
+    static inline const Clock::time_point _start = Clock::now();
+    static inline std::mutex _mutex;  // For adding threads and writing out
+    static inline std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    static inline std::atomic<size_t> _dropped{0};
+};
+
+/** Records the time from its creation to its destruction **/
+class ProfileZone {
+  public:
+    ProfileZone(const char* name)
+        : _name(name), _begin(Profiler::Clock::now()) {}
+    ~ProfileZone() {
+        Profiler::record(_name, _begin, Profiler::Clock::now() - _begin);
+    }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+  private:
+    const char* _name;
+    Profiler::Clock::time_point _begin;
+};
+
+#define VV_PROFILE_CONCAT_IMPL(a, b) a##b
+#define VV_PROFILE_CONCAT(a, b) VV_PROFILE_CONCAT_IMPL(a, b)
+
+// Zones are only recorded if configured with PROFILING, otherwise the macros
+// leave nothing behind. The name must be a string literal.
+#ifdef PROFILING
+#define PROFILE_ZONE(name) \
+    ::VVipers::ProfileZone VV_PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FUNCTION()
+#endif
+
+}  // namespace VVipers
@@ -1,9 +1,112 @@
 #include "vvipers/Utilities/Shape.hpp"
 
 #include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <stdexcept>
 
 namespace VVipers {
 
+namespace {
+double point_segment_distance_squared(const Vec2& point, const Vec2& start,
+                                      const Vec2& end) {
+    Vec2 segment = end - start;
+    double length_squared = segment.squared();
+    double t = length_squared > 0
+                   ? std::clamp((point - start).dot(segment) / length_squared,
+                                0., 1.)
+                   : 0.;
+    return (start + segment * t - point).squared();
+}
+
+bool segments_intersect(const Vec2& a, const Vec2& b, const Vec2& c,
+                        const Vec2& d) {
+    // Each segment must have the end points of the other on opposite sides
+    auto side = [](const Vec2& from, const Vec2& to, const Vec2& point) {
+        return (to - from).perpendicular().dot(point - from);
+    };
+    return side(a, b, c) * side(a, b, d) < 0 &&
+           side(c, d, a) * side(c, d, b) < 0;
+}
+
+double segment_segment_distance_squared(const Vec2& a, const Vec2& b,
+                                        const Vec2& c, const Vec2& d) {
+    if (segments_intersect(a, b, c, d))
+        return 0;
+    return std::min({point_segment_distance_squared(a, c, d),
+                     point_segment_distance_squared(b, c, d),
+                     point_segment_distance_squared(c, a, b),
+                     point_segment_distance_squared(d, a, b)});
+}
+}  // namespace
+
+std::tuple<double, double> Capsule::projection_on_vector(
+    const Vec2& axis) const {
+    auto proj_start = _start.scalar_projection(axis);
+    auto proj_end = _end.scalar_projection(axis);
+    return {std::min(proj_start, proj_end) - _radius,
+            std::max(proj_start, proj_end) + _radius};
+}
+
+void Capsule::move_to(const Vec2& new_center) {
+    auto translation = new_center - 0.5 * (_start + _end);
+    _start += translation;
+    _end += translation;
+}
+
+void Capsule::rotate(double rads) {
+    auto center = 0.5 * (_start + _end);
+    _start = center + (_start - center).rotate(rads);
+    _end = center + (_end - center).rotate(rads);
+}
+
+bool Capsule::overlap(const Shape& other) const {
+    if (!this->bounding_box().overlap(other.bounding_box()))
+        return false;
+    switch (other.type()) {
+        case ShapeType::Capsule: {
+            const Capsule& other_capsule =
+                reinterpret_cast<const Capsule&>(other);
+            double r = _radius + other_capsule._radius;
+            return segment_segment_distance_squared(
+                       _start, _end, other_capsule._start,
+                       other_capsule._end) < r * r;
+        }
+        case ShapeType::Circle: {
+            const Circle& other_circle = reinterpret_cast<const Circle&>(other);
+            double r = _radius + other_circle.radius();
+            return point_segment_distance_squared(other_circle.center(), _start,
+                                                  _end) < r * r;
+        }
+        case ShapeType::Polygon: {
+            const Polygon& other_polygon =
+                reinterpret_cast<const Polygon&>(other);
+            // Either the segment starts inside the polygon or it comes closer
+            // to one of the edges than the radius
+            bool inside = true;
+            for (auto& axis : other_polygon.normal_vectors()) {
+                auto [poly_min, poly_max] =
+                    other_polygon.projection_on_vector(axis);
+                double projection = _start.scalar_projection(axis);
+                if (projection <= poly_min || poly_max <= projection) {
+                    inside = false;
+                    break;
+                }
+            }
+            if (inside)
+                return true;
+            const auto& corners = other_polygon.corners();
+            for (size_t i = 0; i < corners.size(); ++i) {
+                const Vec2& next = corners[(i + 1) % corners.size()];
+                if (segment_segment_distance_squared(_start, _end, corners[i],
+                                                     next) < _radius * _radius)
+                    return true;
+            }
+            return false;
+        }
+    }
+    throw std::runtime_error("Unknown shape type.");
+}
+
 std::tuple<double, double> Circle::projection_on_vector(
     const Vec2& axis) const {
     auto proj = this->_center.scalar_projection(axis);
@@ -14,6 +117,9 @@ std::tuple<double, double> Circle::projection_on_vector(
 
 bool Circle::overlap(const Shape& other) const {
     switch (other.type()) {
+        case ShapeType::Capsule: {
+            return reinterpret_cast<const Capsule&>(other).overlap(*this);
+        }
         case ShapeType::Circle: {
             const Circle& other_circle = reinterpret_cast<const Circle&>(other);
             double r = (this->_radius + other_circle._radius);
@@ -31,6 +137,13 @@ Polygon::Polygon(const std::vector<Vec2>& corners)
     _anchor = Vec2(box.x_max - box.x_min, box.y_max - box.y_min);
 }
 
+void Polygon::set_corners(const std::vector<Vec2>& corners) {
+    _corners.assign(corners.cbegin(), corners.cend());
+    _angle = 0;
+    BoundingBox box = this->bounding_box();
+    _anchor = Vec2(box.x_max - box.x_min, box.y_max - box.y_min);
+}
+
 Polygon::Polygon(const Vec2& rectangle_size)
     : Shape(ShapeType::Polygon), _anchor(0, 0), _angle(0) {
     _corners.emplace_back(-0.5 * rectangle_size.x, +0.5 * rectangle_size.y);
@@ -80,6 +193,9 @@ bool Polygon::overlap(const Shape& other) const {
     if (!this->bounding_box().overlap(other.bounding_box()))
         return false;
     switch (other.type()) {
+        case ShapeType::Capsule: {
+            return reinterpret_cast<const Capsule&>(other).overlap(*this);
+        }
         case ShapeType::Circle: {
             const Circle& other_circle = reinterpret_cast<const Circle&>(other);
             const auto axes = this->normal_vectors();
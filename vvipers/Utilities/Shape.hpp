@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
+
 #include "vvipers/Utilities/Vec2.hpp"
 
 namespace VVipers {
 enum class ShapeType {
     Circle,
     Polygon,
+    Capsule,
 };
 
 class BoundingBox {
@@ -21,6 +24,13 @@ class BoundingBox {
         return !(this->x_min > other.x_max || this->x_max < other.x_min ||
                  this->y_min > other.y_max || this->y_max < other.y_min);
     }
+    /** Grows the box to also cover the other box **/
+    void include(const BoundingBox& other) {
+        x_min = std::min(x_min, other.x_min);
+        x_max = std::max(x_max, other.x_max);
+        y_min = std::min(y_min, other.y_min);
+        y_max = std::max(y_max, other.y_max);
+    }
     double x_min, x_max, y_min, y_max;
 };
 
@@ -71,6 +81,8 @@ class Polygon : public Shape {
     const Vec2& anchor() const { return _anchor; }
     double angle() const { return _angle; }
     const std::vector<Vec2>& corners() const { return _corners; }
+    /** Replaces the corners, reusing the storage of the old ones. **/
+    void set_corners(const std::vector<Vec2>& corners);
     void move_to(const Vec2& new_center) override;
     std::vector<Vec2> normal_vectors() const;
     void set_anchor(const Vec2& new_anchor) { _anchor = new_anchor; };
@@ -83,4 +95,39 @@ class Polygon : public Shape {
     double _angle;
     std::vector<Vec2> _corners;
 };
+
+/** A line segment with a radius, i.e. a rectangle with rounded ends. **/
+class Capsule : public Shape {
+  public:
+    Capsule(const Vec2& start, const Vec2& end, double radius)
+        : Shape(ShapeType::Capsule),
+          _start(start),
+          _end(end),
+          _radius(radius) {}
+    BoundingBox bounding_box() const override {
+        return {std::min(_start.x, _end.x) - _radius,
+                std::max(_start.x, _end.x) + _radius,
+                std::min(_start.y, _end.y) - _radius,
+                std::max(_start.y, _end.y) + _radius};
+    }
+    const Vec2& start() const { return _start; }
+    const Vec2& end() const { return _end; }
+    double radius() const { return _radius; }
+    void set(const Vec2& start, const Vec2& end, double radius) {
+        _start = start;
+        _end = end;
+        _radius = radius;
+    }
+    /** Moves the midpoint to new_center **/
+    void move_to(const Vec2& new_center) override;
+    bool overlap(const Shape&) const override;
+    std::tuple<double, double> projection_on_vector(const Vec2&) const override;
+    /** Rotates around the midpoint **/
+    void rotate(double) override;
+
+  private:
+    Vec2 _start;
+    Vec2 _end;
+    double _radius;
+};
 }  // namespace VVipers
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "vvipers/Utilities/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace VVipers {
+
+ThreadPool::ThreadPool(size_t number_of_threads)
+    : _task(nullptr),
+      _count(0),
+      _next_index(0),
+      _unfinished(0),
+      _generation(0),
+      _stopping(false) {
+    for (size_t i = 0; i < number_of_threads; ++i)
+        _threads.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _work_available.notify_all();
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+size_t ThreadPool::default_number_of_threads() {
+    // hardware_concurrency() returns 0 if it is unknown
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+}
+
+void ThreadPool::parallel_for(size_t count,
+                              const std::function<void(size_t)>& task) {
+    if (count == 0)
+        return;
+    {
+        std::lock_guard lock(_mutex);
+        _task = &task;
+        _count = count;
+        _next_index = 0;
+        _unfinished = count;
+        _exception = nullptr;
+        ++_generation;
+    }
+    _work_available.notify_all();
+    run_tasks();
+
+    std::unique_lock lock(_mutex);
+    _work_done.wait(lock, [this] { return _unfinished == 0; });
+    _task = nullptr;
+    if (_exception)
+        std::rethrow_exception(_exception);
+}
+
+// Takes one index at a time until there are none left
+void ThreadPool::run_tasks() {
+    std::unique_lock lock(_mutex);
+    while (_task && _next_index < _count) {
+        auto task = _task;
+        size_t index = _next_index++;
+        lock.unlock();
+        std::exception_ptr exception;
+        try {
+            (*task)(index);
+        } catch (...) {
+            exception = std::current_exception();
+        }
+        lock.lock();
+        if (exception && !_exception)
+            _exception = exception;
+        if (--_unfinished == 0)
+            _work_done.notify_all();
+    }
+}
+
+void ThreadPool::work() {
+    uint64_t generation = 0;
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _work_available.wait(lock, [&] {
+            return _stopping || _generation != generation;
+        });
+        if (_stopping)
+            return;
+        generation = _generation;
+        lock.unlock();
+        run_tasks();
+        lock.lock();
+    }
+}
+
+}  // namespace VVipers
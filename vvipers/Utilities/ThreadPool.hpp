@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VVipers {
+
+/** A fixed set of worker threads that run the iterations of a loop in
+ * parallel. The calling thread takes part in the work as well. **/
+class ThreadPool {
+  public:
+    /** By default one thread less than the hardware supports is started,
+     * since the calling thread also does work. **/
+    ThreadPool(size_t number_of_threads = default_number_of_threads());
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    size_t size() const { return _threads.size(); }
+    /** Calls task(i) for every i in [0, count) and returns when all calls
+     * have finished. The first exception thrown by a task is rethrown. **/
+    void parallel_for(size_t count, const std::function<void(size_t)>& task);
+    static size_t default_number_of_threads();
+
+  private:
+    void run_tasks();
+    void work();
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _work_available;
+    std::condition_variable _work_done;
+    const std::function<void(size_t)>* _task;
+    size_t _count;
+    size_t _next_index;
+    size_t _unfinished;
+    uint64_t _generation;  // Wakes the workers for every new loop
+    bool _stopping;
+    std::exception_ptr _exception;
+};
+
+}  // namespace VVipers
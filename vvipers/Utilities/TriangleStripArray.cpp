@@ -14,34 +14,63 @@ void TriangleStripArray::draw(sf::RenderTarget& target,
                 states);
 }
 
+void TriangleStripArray::draw_range(sf::RenderTarget& target,
+                                    sf::RenderStates states, size_t begin,
+                                    size_t end) const {
+    if (end <= begin)
+        return;
+    states.texture = texture;
+    target.draw(&vertices[begin], end - begin,
+                sf::PrimitiveType::TriangleStrip, states);
+}
+
+void TriangleStripArray::append_triangles(
+    std::vector<sf::Vertex>& triangles) const {
+    for (size_t i = 0; i + 2 < vertices.size(); ++i)
+        triangles.insert(triangles.end(), vertices.cbegin() + i,
+                         vertices.cbegin() + i + 3);
+}
+
 std::vector<Polygon> TriangleStripArray::create_polygons(
     size_t number_of_polygons) const {
+    std::vector<Polygon> polygons;
+    std::vector<Vec2> corners;
+    for (size_t poly_index = 0; poly_index < number_of_polygons; ++poly_index) {
+        polygon_corners(corners, poly_index, number_of_polygons);
+        polygons.emplace_back(corners);
+    }
+    return polygons;
+}
+
+void TriangleStripArray::polygon_corners(std::vector<Vec2>& corners,
+                                         size_t poly_index,
+                                         size_t number_of_polygons) const {
+    auto [begin_index, end_index] =
+        polygon_vertex_range(poly_index, number_of_polygons);
+    size_t number_of_corners = end_index - begin_index;
+    corners.resize(number_of_corners);
+    for (size_t vertex_index = 0; vertex_index < number_of_corners;
+         ++vertex_index) {
+        size_t corner_index = vertex_index % 2 == 0
+                                  ? number_of_corners - 1 - vertex_index / 2
+                                  : vertex_index / 2;
+        corners[corner_index] = vertices[begin_index + vertex_index].position;
+    }
+}
+
+std::pair<size_t, size_t> TriangleStripArray::polygon_vertex_range(
+    size_t poly_index, size_t number_of_polygons) const {
     if (number_of_polygons > vertices.size() - 2)
         throw std::runtime_error("Requesting too many polygons.");
     size_t vertices_per_polygon =
         (vertices.size() - 2) / number_of_polygons + 2;
 
-    std::vector<Polygon> polygons;
-    for (size_t poly_index = 0; poly_index < number_of_polygons; ++poly_index) {
-        size_t begin_index = poly_index * (vertices_per_polygon - 2);
-        size_t end_index = begin_index + vertices_per_polygon;
-        // The last polygon might have more vertices
-        if (poly_index == number_of_polygons - 1) {
-            end_index = vertices.size();
-        }
-        std::vector<Vec2> corners;
-        size_t number_of_corners = end_index - begin_index;
-        corners.resize(number_of_corners);
-        for (size_t vertex_index = 0; vertex_index < number_of_corners;
-             ++vertex_index) {
-            size_t corner_index = vertex_index % 2 == 0
-                                      ? number_of_corners - 1 - vertex_index / 2
-                                      : vertex_index / 2;
-            corners[corner_index] =
-                vertices[begin_index + vertex_index].position;
-        }
-        polygons.emplace_back(std::move(corners));
+    size_t begin_index = poly_index * (vertices_per_polygon - 2);
+    size_t end_index = begin_index + vertices_per_polygon;
+    // The last polygon might have more vertices
+    if (poly_index == number_of_polygons - 1) {
+        end_index = vertices.size();
     }
-    return polygons;
+    return {begin_index, end_index};
 }
 }  // namespace VVipers
\ No newline at end of file
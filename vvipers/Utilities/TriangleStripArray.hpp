@@ -3,6 +3,7 @@
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
+#include <utility>
 #include <vector>
 
 #include "vvipers/Utilities/Shape.hpp"
@@ -12,7 +13,20 @@ class TriangleStripArray : public sf::Drawable {
   public:
     TriangleStripArray() : texture(nullptr) {}
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    /** Draws only the vertices in [begin, end) **/
+    void draw_range(sf::RenderTarget& target, sf::RenderStates states,
+                    size_t begin, size_t end) const;
     std::vector<Polygon> create_polygons(size_t) const;
+    /** Appends the triangles of the strip as a triangle list, which unlike
+     * strips can be drawn together with other lists in a single call. **/
+    void append_triangles(std::vector<sf::Vertex>& triangles) const;
+    /** Writes the corners of one of the polygons create_polygons would create
+     * into corners, reusing its storage. **/
+    void polygon_corners(std::vector<Vec2>& corners, size_t polygon_index,
+                         size_t number_of_polygons) const;
+    /** @returns the first and one past the last vertex of the polygon **/
+    std::pair<size_t, size_t> polygon_vertex_range(
+        size_t polygon_index, size_t number_of_polygons) const;
     std::vector<sf::Vertex> vertices;
     const sf::Texture* texture;
 };
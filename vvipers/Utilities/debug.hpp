@@ -3,12 +3,15 @@
 #include <iostream>
 #include <source_location>
 #include <string_view>
+#include <vvipers/Utilities/Logger.hpp>
+#include <vvipers/config.hpp>
 
 namespace VVipers {
 
 enum class Verbosity { Silent = 0, OnlyErrors, ErrorsAndWarnings, All };
 
 namespace debug {
+/** Filters the levels compiled in, LOG_LEVEL from CMake removes the others **/
 inline Verbosity verbosity = Verbosity::All;
 }
 
@@ -53,21 +56,21 @@ inline void debug_tag(
     const std::source_location& location = std::source_location()) {}
 #endif
 
+/** Info is written by the logging thread. Warnings, errors and debug output
+ * are written at once, so they are not lost if the program goes down. **/
 template <typename... Args>
 inline void _impl_log_info(bool doTag, const std::source_location loc,
                            Args&&... args) {
-    if (debug::verbosity >= Verbosity::All) {
-        if (doTag)
-            tag(loc, std::cout);
-        std::cout << "   INFO   ";
-        (std::cout << ... << std::forward<Args>(args)) << '\n';
-    }
+    if (debug::verbosity >= Verbosity::All)
+        Logger::instance().push(std::cout, doTag, loc, "   INFO   ",
+                                std::forward<Args>(args)...);
 }
 
 template <typename... Args>
 inline void _impl_log_warning(bool doTag, const std::source_location loc,
                               Args&&... args) {
     if (debug::verbosity >= Verbosity::ErrorsAndWarnings) {
+        Logger::instance().flush();  // Keeps the order of the records
         if (doTag)
             tag(loc, std::cerr);
         std::cerr << "   WARN   ";
@@ -79,6 +82,7 @@ template <typename... Args>
 inline void _impl_log_error(bool doTag, const std::source_location loc,
                             Args&&... args) {
     if (debug::verbosity >= Verbosity::OnlyErrors) {
+        Logger::instance().flush();  // Keeps the order of the records
         if (doTag)
             tag(loc, std::cerr);
         std::cerr << "   ERR    ";
@@ -89,6 +93,7 @@ inline void _impl_log_error(bool doTag, const std::source_location loc,
 template <typename... Args>
 inline void _impl_log_debug(bool doTag, const std::source_location loc,
                             Args&&... args) {
+    Logger::instance().flush();
     if (doTag)
         tag(loc, std::cerr);
     std::cerr << "   DEBUG  ";
@@ -98,37 +103,37 @@ inline void _impl_log_debug(bool doTag, const std::source_location loc,
 #ifndef __INTELLISENSE__  // Because intellisense bugs on
                           // std::source_location::current() and this removes
                           // the error squiggles
-#define log_info(...) \
-    _impl_log_info(false, std::source_location::current(), __VA_ARGS__)
-#define logWarning(...) \
-    _impl_log_warning(false, std::source_location::current(), __VA_ARGS__)
-#define log_error(...) \
-    _impl_log_error(false, std::source_location::current(), __VA_ARGS__)
-#define log_debug(...) \
-    _impl_log_debug(false, std::source_location::current(), __VA_ARGS__)
-#define tag_info(...) \
-    _impl_log_info(true, std::source_location::current(), __VA_ARGS__)
-#define tag_warning(...) \
-    _impl_log_warning(true, std::source_location::current(), __VA_ARGS__)
-#define tag_error(...) \
-    _impl_log_error(true, std::source_location::current(), __VA_ARGS__)
-#define tag_debug(...) \
-    _impl_log_debug(true, std::source_location::current(), __VA_ARGS__)
+#define _impl_log_location std::source_location::current()
 #else
-#define log_info(...) _impl_log_info(false, std::source_location(), __VA_ARGS__)
-#define log_warning(...) \
-    _impl_log_warning(false, std::source_location(), __VA_ARGS__)
-#define log_error(...) \
-    _impl_log_error(false, std::source_location(), __VA_ARGS__)
-#define log_debug(...) \
-    _impl_log_debug(false, std::source_location(), __VA_ARGS__)
-#define tag_info(...) _impl_log_info(true, std::source_location(), __VA_ARGS__)
-#define tag_warning(...) \
-    _impl_log_warning(true, std::source_location(), __VA_ARGS__)
-#define tag_error(...) \
-    _impl_log_error(true, std::source_location(), __VA_ARGS__)
-#define tag_debug(...) \
-    _impl_log_debug(true, std::source_location(), __VA_ARGS__)
+#define _impl_log_location std::source_location()
+#define log_warning logWarning
 #endif
 
+/* Levels above LOG_LEVEL become empty statements, whose arguments are never
+ * evaluated */
+#define _impl_log_if(level, call)                    \
+    do {                                             \
+        if constexpr (LOG_LEVEL >= Verbosity::level) \
+            call;                                    \
+    } while (false)
+
+#define log_info(...) \
+    _impl_log_if(All, _impl_log_info(false, _impl_log_location, __VA_ARGS__))
+#define logWarning(...)             \
+    _impl_log_if(ErrorsAndWarnings, \
+                 _impl_log_warning(false, _impl_log_location, __VA_ARGS__))
+#define log_error(...)       \
+    _impl_log_if(OnlyErrors, \
+                 _impl_log_error(false, _impl_log_location, __VA_ARGS__))
+#define log_debug(...) _impl_log_debug(false, _impl_log_location, __VA_ARGS__)
+#define tag_info(...) \
+    _impl_log_if(All, _impl_log_info(true, _impl_log_location, __VA_ARGS__))
+#define tag_warning(...)            \
+    _impl_log_if(ErrorsAndWarnings, \
+                 _impl_log_warning(true, _impl_log_location, __VA_ARGS__))
+#define tag_error(...)       \
+    _impl_log_if(OnlyErrors, \
+                 _impl_log_error(true, _impl_log_location, __VA_ARGS__))
+#define tag_debug(...) _impl_log_debug(true, _impl_log_location, __VA_ARGS__)
+
 }  // namespace VVipers
\ No newline at end of file